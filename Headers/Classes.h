@@ -5,12 +5,23 @@
 class ModelBase;
 
 // Curves
+class ArcLengthTable;
+class BernsteinTableCache;
 class BezierCurve;
+class BezierEvaluator;
 class BSpline;
+class BSplineFitter;
+class CurveIntersector;
+class CurveProjector;
 class DiscreteCurve;
+class PointQueue;
+class PolylineGeometry;
+class PolylineSimplifier;
 
 // Surfaces
 class BezierDurface;
+class BezierSurfaceEvaluator;
+class GridIndexCache;
 class BezierSurfaceInterpolation;
 
 // Models
@@ -29,9 +40,12 @@ class Transformation;
 struct Material;
 
 // Types
+struct BernsteinTable;
 struct BezierCurveParams;
 struct BezierSurfaceParams;
 struct BSplineParams;
+struct CurveIntersection;
+struct CurveProjection;
 struct DiscreteCurveParams;
 struct MeshRenderParams;
 struct MeshRenderSelectionParams;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Arc-length table of a piecewise Bezier curve, the common form of every curve type
+ * (Bezier segments, the Bezier spans of a B-Spline, the linear pieces of a discrete curve).
+ * Span i is defined on [breaks[i], breaks[i+1]] of the curve parameter. Each span is divided into
+ * SUBDIVISIONS intervals, the length of an interval is computed with 5 point Gauss-Legendre quadrature
+ * from the hodograph of the span. Spans of rational curves have homogeneous control points,
+ * their speed comes from the quotient rule.
+ * A polyline is built directly from its cumulative chord lengths, one entry per vertex, since the length
+ * of a straight piece is exact and the parameter is linear in the arc length inside it.
+ */
+class ArcLengthTable {
+protected:
+	static constexpr int SUBDIVISIONS = 8;
+	static constexpr int NEWTON_ITERATIONS = 4;
+
+	std::vector<BezierEvaluator> m_hodographs{};	// derivative of every span over its local [0, 1]
+	std::vector<BezierEvaluator> m_rationalSpans{};	// homogeneous control points of the rational spans, empty for polynomial ones
+	std::vector<float> m_breaks{};
+	std::vector<float> m_params{};		// interval end points, SUBDIVISIONS per span
+	std::vector<float> m_lengths{};		// arc length at m_params
+	bool m_polyline = false;			// built by BuildPolyline, m_params are the vertex indices
+	GLuint m_ssboID = 0;
+	int m_ssboDivision = 0;
+
+	glm::vec3 Derivative(int span, float t) const;
+	float IntegrateSpeed(int span, float t0, float t1) const;
+
+public:
+	ArcLengthTable() = default;
+	~ArcLengthTable();
+	ArcLengthTable(const ArcLengthTable&) = delete;
+	ArcLengthTable& operator=(const ArcLengthTable&) = delete;
+
+	/**
+	 * @brief Rebuilds the table, the SSBO is rewritten on the next GetSSBO call.
+	 * @param spans control points of the Bezier spans
+	 * @param breaks spans.size() + 1 increasing parameter values
+	 */
+	void Build(const std::vector<std::vector<glm::vec4>>& spans, const std::vector<float>& breaks);
+	/**
+	 * @brief Rebuilds the table of the polyline through points, vertex i is at parameter i.
+	 */
+	void BuildPolyline(const std::vector<glm::vec4>& points);
+
+	inline bool IsEmpty() const {
+		return m_lengths.empty();
+	}
+	inline float GetLength() const {
+		return m_lengths.empty() ? 0.f : m_lengths.back();
+	}
+	inline float GetStart() const {
+		return m_params.empty() ? 0.f : m_params.front();
+	}
+	inline float GetEnd() const {
+		return m_params.empty() ? 0.f : m_params.back();
+	}
+
+	/**
+	 * @brief Arc length from the start of the curve to parameter t.
+	 */
+	float GetLength(float t) const;
+	/**
+	 * @brief Parameter where the arc length is s: binary search in the table, then Newton iterations.
+	 */
+	float GetParam(float s) const;
+	/**
+	 * @brief count parameters placed evenly by arc length, including both ends.
+	 */
+	void GetUniformParams(int count, std::vector<float>& out) const;
+	/**
+	 * @brief SSBO of division parameters placed evenly by arc length (float array), rebuilt if the division changes.
+	 * Has to be called from the thread owning the OpenGL context.
+	 */
+	GLuint GetSSBO(int division);
+};
\ No newline at end of file
@@ -5,28 +5,109 @@
 class BSpline : public ModelBase {
 protected:
     std::vector<glm::vec4> m_interpolatedPoints{};
-    std::vector<glm::vec4> m_ctrlPoints{};
+    std::vector<glm::vec4> m_ctrlPoints{};          // homogeneous (w x, w y, w z, w), w is the weight of a rational curve
     std::vector<float> m_knots{};
     GLuint m_interpolatedPointsSSBOID = 0;
     GLuint m_ctrlPointsSSBOID = 0;
     GLuint m_knotsSSBOID = 0;
     bool m_ctrlPointsDirty = false;
+    int m_ctrlPointsDirtyBegin = 0;         // control points changed since the last upload, [begin, end)
+    int m_ctrlPointsDirtyEnd = 0;
     bool m_knotsDirty = false;
+    int m_knotsDirtyBegin = 0;              // knots changed since the last upload, [begin, end)
+    int m_knotsDirtyEnd = 0;
+    int m_ctrlPointsCapacity = 0;           // sizes of the GPU buffers, they only grow
+    int m_knotsCapacity = 0;
+    std::vector<glm::vec4> m_curveCtrlPoints{};     // transformed control points of the curve, in sync with the SSBO
     int m_smoothness = 20;
     glm::vec3 m_color = { 1.f, 1.f, 0 };
 
-    static constexpr int m_degree = 3; // cubic only
+    int m_degree = 3;
+    bool m_periodic = false;    // closed curve, the first m_degree control points are repeated after the last one
 
+    TessellationMode m_tessellationMode = TessellationMode::Shader;
+    float m_tolerance = 0.01f;
+    bool m_screenSpaceTolerance = false;
+    GLuint m_tessellationVAOID = 0;
+    GLuint m_tessellationVBOID = 0;
+    int m_tessellationVertexCount = 0;
+    int m_tessellationCapacity = 0;
+    bool m_tessellationDirty = true;
+    int m_tessellationDirtyBegin = 0;       // curve control points whose spans have to be re-tessellated, [begin, end)
+    int m_tessellationDirtyEnd = 0;
+    glm::mat4 m_tessellationViewProj{};     // camera of the last screen space tessellation
+    glm::ivec2 m_tessellationViewport{};
+
+    GLuint m_spansSSBOID = 0;               // scaled Bernstein coefficients of the Bezier spans
+    int m_spanCount = 0;
+    int m_spansCapacity = 0;
+    bool m_spansDirty = true;
+    int m_spansDirtyBegin = 0;              // control points whose Bezier spans have to be extracted again, [begin, end)
+    int m_spansDirtyEnd = 0;
+    std::vector<int> m_spanKnots{};         // knot span of every Bezier span in the SSBO
+    bool m_spanEvaluation = false;          // the shader evaluates the cached Bezier spans instead of the B-Spline
+
+    GLuint m_samplesSSBOID = 0;             // first control point and basis functions of every sample
+    int m_samplesCapacity = 0;
+    int m_samplesDivision = 0;              // division the samples were computed for
+    bool m_samplesDirty = true;
+
+    ArcLengthTable m_arcLengthTable{};      // parameter runs over the knot domain
+    bool m_arcLengthDirty = true;
+    bool m_arcLengthSampling = false;       // place the samples evenly by arc length
+    ArcLengthTable m_renderArcLengthTable{};    // the same for the transformed curve, spaces the rendered samples
+    bool m_renderArcLengthDirty = true;
+
+    std::vector<glm::vec4> GetTransformedCtrlPoints() const;
+    /**
+     * @brief Arc-length table of the transformed curve, rebuilt if the control points, the knots or the transformation changed.
+     * The rendered samples are spaced with it, so they stay even under a non-uniform scale or shear.
+     */
+    ArcLengthTable& GetRenderArcLengthTable();
+    std::vector<glm::vec4> GetCurveCtrlPoints(const std::vector<glm::vec4>& points) const;
+    void GetDomain(float& start, float& end) const;
+    void ResetKnots(float start, float end);
     void SetCtrlPointsSSBO();
     void WriteCtrlPointsSSBO();
     void SetInterpolatedPointsSSBO();
     void WriteInterpolatedPointsSSBO();
     void SetKnotsSSBO();
     void WriteKnotsSSBO();
+    void SetTessellationVBO();
+    void WriteTessellationVBO(RenderParams* p);
+    void UpdateTessellationVBO();
+    void WriteSpansSSBO();
+    void UpdateSpansSSBO();
+    void RewriteSpans(int first, int last);
+    void WriteSamplesSSBO();
+    void RetessellateSpans(int first, int last);
+
+    inline void MarkCtrlPointsDirty(int begin, int end) {
+        if (m_ctrlPointsDirty) {
+            begin = glm::min(begin, m_ctrlPointsDirtyBegin);
+            end = glm::max(end, m_ctrlPointsDirtyEnd);
+        }
+        m_ctrlPointsDirtyBegin = begin;
+        m_ctrlPointsDirtyEnd = end;
+        m_ctrlPointsDirty = true;
+        m_arcLengthDirty = true;
+        m_renderArcLengthDirty = true;
+    }
+    inline void MarkKnotsDirty(int begin, int end) {
+        if (m_knotsDirty) {
+            begin = glm::min(begin, m_knotsDirtyBegin);
+            end = glm::max(end, m_knotsDirtyEnd);
+        }
+        m_knotsDirtyBegin = begin;
+        m_knotsDirtyEnd = end;
+        m_knotsDirty = true;
+        m_arcLengthDirty = true;
+        m_renderArcLengthDirty = true;
+    }
 
 public:
     /**
-     * @brief Creates a cubic B-Spline curve that interpolates the given data points (Q)
+     * @brief Creates a B-Spline curve of degree params.degree that interpolates the given data points (Q)
      * by automatically calculating the t parameters using the Centripetal Chord Length method.
      * @param dataPoints The points (Q_i) the curve must pass through.
      * @param params BSpline rendering parameters.
@@ -38,12 +119,14 @@ public:
     );
 
     /**
-     * @brief Creates a cubic B-Spline curve that interpolates the given data points (Q)
+     * @brief Creates a B-Spline curve of degree params.degree that interpolates the given data points (Q)
      * using user-defined t parameters (t_values).
      * * The t_values MUST have the same size as dataPoints. The t_values define where the
      * curve must pass through Q_i (i.e., Q_i = C(t_i)).
-     * * @param dataPoints The points (Q_i) the curve must pass through.
+     * * @param dataPoints The points (Q_i) the curve must pass through, w is the weight of the curve at Q_i
+     * (1 for a polynomial curve, other positive values give a rational one).
      * @param t_values The user-defined parametric values (t_0, t_1, ..., t_{n-1}).
+     * For a closed curve (params.periodic) one more value t_n closes the loop, Q_0 = C(t_0) = C(t_n).
      * @param params BSpline rendering parameters.
      * @return BSpline* The new interpolated B-Spline object, or nullptr on failure.
      */
@@ -53,6 +136,20 @@ public:
         BSplineParams params
     );
 
+    /**
+     * @brief Creates a B-Spline curve of degree params.degree with ctrlPointCount control points that approximates
+     * the data points in the least-squares sense, using centripetal parameters and a clamped uniform knot vector.
+     * Meant for large point sets, see BSplineFitter.
+     * @param correctionSteps number of parameter correction passes after the first fit.
+     * @return BSpline* The new approximating B-Spline object, or nullptr on failure.
+     */
+    static BSpline* CreateApproximated(
+        const std::vector<glm::vec4>& dataPoints,
+        int ctrlPointCount,
+        BSplineParams params,
+        int correctionSteps = 0
+    );
+
     BSpline(BSplineParams params);
     ~BSpline();
 
@@ -61,10 +158,31 @@ public:
     void RenderInterpolatedPoints(RenderParams* p);
     void RenderGUI(std::vector<ModelBase*>* models) override;
 
+    /**
+     * @brief Creates the exact circular arc of the given radius around center in the plane of xAxis and yAxis,
+     * from startAngle to endAngle (radians, counterclockwise from xAxis), as a rational quadratic B-Spline.
+     * The arc is split into pieces of at most 90 degrees, the middle control point of a piece of angle a
+     * has weight cos(a / 2). A full circle is closed at its start point.
+     * @return BSpline* The new rational B-Spline object, or nullptr on failure.
+     */
+    static BSpline* CreateArc(
+        glm::vec3 center,
+        glm::vec3 xAxis,
+        glm::vec3 yAxis,
+        float radius,
+        float startAngle,
+        float endAngle,
+        BSplineParams params
+    );
+
     // Control points
-    inline void AddCtrlPoint(glm::vec3 newPoint) {
-        m_ctrlPoints.push_back(glm::vec4(newPoint, 1));
-        m_ctrlPointsDirty = true;
+    inline void AddCtrlPoint(glm::vec3 newPoint, float weight = 1.f) {
+        if (weight <= 0.f) {
+            Log::errorToConsole("BSpline::AddCtrlPoint weight must be positive");
+            return;
+        }
+        m_ctrlPoints.push_back(BezierAlgorithms::Homogenize(newPoint, weight));
+        MarkCtrlPointsDirty(m_ctrlPoints.size() - 1, m_ctrlPoints.size());
     }
     inline void DelCtrlPoint(int index) {
         if (index < 0 || index > m_ctrlPoints.size() - 1) {
@@ -72,23 +190,60 @@ public:
             return;
         }
         m_ctrlPoints.erase(m_ctrlPoints.begin() + index);
-        m_ctrlPointsDirty = true;
+        MarkCtrlPointsDirty(index, m_ctrlPoints.size());
     }
+    /**
+     * @brief Moves the control point, its weight does not change.
+     */
     inline void SetCtrlPoint(int index, glm::vec3 position) {
         if (index < 0 || index > m_ctrlPoints.size() - 1) {
             Log::errorToConsole("BSpline::SetCtrlPoint invalid index");
             return;
         }
-        m_ctrlPoints[index] = glm::vec4(position, 1);
-        m_ctrlPointsDirty = true;
+        m_ctrlPoints[index] = BezierAlgorithms::Homogenize(position, m_ctrlPoints[index].w);
+        MarkCtrlPointsDirty(index, index + 1);
     }
+    /**
+     * @brief Changes the weight of the control point, its position does not change.
+     * A larger weight pulls the curve towards the control point.
+     */
+    inline void SetCtrlPointWeight(int index, float weight) {
+        if (index < 0 || index > m_ctrlPoints.size() - 1) {
+            Log::errorToConsole("BSpline::SetCtrlPointWeight invalid index");
+            return;
+        }
+        if (weight <= 0.f) {
+            Log::errorToConsole("BSpline::SetCtrlPointWeight weight must be positive");
+            return;
+        }
+        m_ctrlPoints[index] = BezierAlgorithms::Homogenize(GetCtrlPointPosition(index), weight);
+        MarkCtrlPointsDirty(index, index + 1);
+    }
+    inline glm::vec3 GetCtrlPointPosition(int index) const {
+        return BezierAlgorithms::Dehomogenize(m_ctrlPoints[index]);
+    }
+    inline float GetCtrlPointWeight(int index) const {
+        return m_ctrlPoints[index].w;
+    }
+    /**
+     * @brief Sets the control points in homogeneous form (w x, w y, w z, w), w = 1 for a polynomial curve.
+     */
     inline void SetCtrlPoints(std::vector<glm::vec4> points) {
         m_ctrlPoints = points;
-        m_ctrlPointsDirty = true;
+        MarkCtrlPointsDirty(0, m_ctrlPoints.size());
     }
+    /**
+     * @brief Control points in homogeneous form, see GetCtrlPointPosition for the Cartesian ones.
+     */
     inline std::vector<glm::vec4> GetCtrlPoints() const {
         return m_ctrlPoints;
     }
+    /**
+     * @brief The curve is rational (NURBS) if any weight differs from 1.
+     */
+    inline bool IsRational() const {
+        return BezierAlgorithms::IsRational(m_ctrlPoints);
+    }
     inline int GetCtrlPointCount() const {
         return m_ctrlPoints.size();
     }
@@ -124,7 +279,7 @@ public:
     // Knot vector
     inline void AddKnot(float knot) {
         m_knots.push_back(knot);
-        m_knotsDirty = true;
+        MarkKnotsDirty(m_knots.size() - 1, m_knots.size());
     }
     inline void DelKnot(int index) {
         if (index < 0 || index >= m_knots.size()) {
@@ -132,11 +287,11 @@ public:
             return;
         }
         m_knots.erase(m_knots.begin() + index);
-        m_knotsDirty = true;
+        MarkKnotsDirty(index, m_knots.size());
     }
     inline void SetKnots(std::vector<float> knots) {
         m_knots = knots;
-        m_knotsDirty = true;
+        MarkKnotsDirty(0, m_knots.size());
     }
     inline void SetKnot(int index, float knot) {
         if (index < 0 || index >= m_knots.size()) {
@@ -144,7 +299,7 @@ public:
             return;
         }
         m_knots[index] = knot;
-        m_knotsDirty = true;
+        MarkKnotsDirty(index, index + 1);
     }
     inline std::vector<float> GetKnots() const {
         return m_knots;
@@ -155,6 +310,26 @@ public:
     inline GLuint GetKnotsSSBO() const {
         return m_knotsSSBOID;
     }
+    /**
+     * @brief Inserts the knot u times times and updates the control points, the shape of the curve does not change.
+     * Unlike AddKnot, which only edits the knot vector. Rational curves are refined in homogeneous form.
+     */
+    void InsertKnot(float u, int times = 1);
+    /**
+     * @brief Inserts all knots at once without changing the shape of the curve.
+     */
+    void RefineKnots(std::vector<float> knots);
+    /**
+     * @brief Inserts the midpoint of every nonempty knot span, doubling the resolution of the curve.
+     */
+    void RefineUniformly();
+    /**
+     * @brief Removes interior knots while the curve stays within tolerance of its current shape,
+     * every removed knot removes a control point as well. The removal works on the homogeneous control points,
+     * for a rational curve the tolerance is scaled down by the smallest weight and the largest point.
+     * @return number of removed knots.
+     */
+    int RemoveKnots(float tolerance);
 
     // prevent GetTransform to reset m_transformDirty and Transformation::m_dirty
     inline glm::mat4 GetTransform() const {
@@ -163,6 +338,9 @@ public:
 
     // Render settings
     inline void SetSmoothness(int smoothness) {
+        if (smoothness != m_smoothness) {
+            m_tessellationDirty = true;
+        }
         m_smoothness = smoothness;
     }
     inline int GetSmoothness() const {
@@ -172,14 +350,94 @@ public:
         m_applyTransforms = apply;
         m_transformDirty = true;
     }
+    inline void SetTessellationMode(TessellationMode mode) {
+        m_tessellationMode = mode;
+        m_tessellationDirty = true;
+    }
+    inline TessellationMode GetTessellationMode() const {
+        return m_tessellationMode;
+    }
+    inline void SetTolerance(float tolerance, bool screenSpace) {
+        m_tolerance = glm::max(tolerance, CurveTessellation::EPSILON);
+        m_screenSpaceTolerance = screenSpace;
+        m_tessellationDirty = true;
+    }
+    inline float GetTolerance() const {
+        return m_tolerance;
+    }
+    inline bool GetScreenSpaceTolerance() const {
+        return m_screenSpaceTolerance;
+    }
     inline void SetColor(glm::vec3 color) {
         m_color = color;
     }
     inline glm::vec3 GetColor() const {
         return m_color;
     }
+    /**
+     * @brief Changes the degree (1 ... BSplineAlgorithms::MAX_DEGREE), the knot vector is replaced
+     * by a clamped uniform one over the current parameter domain.
+     */
+    void SetDegree(int degree);
     inline int GetDegree() const {
         return m_degree;
     }
+    /**
+     * @brief Opens or closes the curve, the knot vector is replaced by a uniform clamped or periodic one
+     * over the current parameter domain.
+     */
+    void SetPeriodic(bool periodic);
+    inline bool GetPeriodic() const {
+        return m_periodic;
+    }
+    /**
+     * @brief Number of control points the curve is evaluated with, including the repeated ones of a closed curve.
+     */
+    inline int GetCurveCtrlPointCount() const {
+        return GetCtrlPointCount() + (m_periodic ? m_degree : 0);
+    }
+    inline void SetArcLengthSampling(bool arcLength) {
+        m_arcLengthSampling = arcLength;
+        m_tessellationDirty = true;
+    }
+    inline bool GetArcLengthSampling() const {
+        return m_arcLengthSampling;
+    }
+    /**
+     * @brief The shader draws the curve span by span from its Bezier decomposition, cached on the CPU,
+     * with GetSmoothness() samples spread evenly over the spans. Used when the curve is not tessellated on the CPU
+     * and not sampled by arc length.
+     */
+    inline void SetSpanEvaluation(bool spans) {
+        m_spanEvaluation = spans;
+    }
+    inline bool GetSpanEvaluation() const {
+        return m_spanEvaluation;
+    }
+
+    /**
+     * @brief Splits the curve into Bezier spans, span i is defined on [breaks[i], breaks[i+1]].
+     * @param world if set, the control points are transformed like the rendered curve.
+     */
+    void GetBezierSpans(std::vector<std::vector<glm::vec4>>& spans, std::vector<float>& breaks, bool world = false) const;
+    /**
+     * @brief Arc-length table of the untransformed curve built from its Bezier spans,
+     * rebuilt if the control points or the knots changed. Lengths are measured in the local space of the curve.
+     */
+    ArcLengthTable& GetArcLengthTable();
+    /**
+     * @brief Point of the untransformed curve at arc length s from the start.
+     */
+    glm::vec4 GetPointAtLength(float s);
+
+    /**
+     * @brief Closest point queries on the untransformed curve, built from its Bezier spans.
+     * Build it once and reuse it for every point of a batch.
+     */
+    CurveProjector GetProjector() const;
+    /**
+     * @brief Projects every point onto the untransformed curve, on multiple threads.
+     */
+    std::vector<CurveProjection> Project(const std::vector<glm::vec3>& points, int threadCount = 0) const;
     
 };
\ No newline at end of file
@@ -0,0 +1,572 @@
+#pragma once
+
+#include "../include_all.h"
+
+// Knot vector based B-Spline algorithms (numbering follows The NURBS Book).
+// n is the index of the last control point, p is the degree, U is the knot vector.
+namespace BSplineAlgorithms {
+
+	constexpr float EPSILON = 1e-6f;
+	constexpr int MAX_DEGREE = 7;		// highest degree with a specialized kernel
+
+	/**
+	 * @brief Checks if the knot vector fits the control points (n + p + 2 knots).
+	 */
+	inline bool IsValid(int p, const std::vector<float>& U, const std::vector<glm::vec4>& P) {
+		return p >= 1 && P.size() >= p + 1 && U.size() == P.size() + p + 1;
+	}
+
+	/**
+	 * @brief Index i of the knot span with U[i] <= u < U[i+1], in [p, n] (A2.1).
+	 */
+	inline int FindSpan(int n, int p, float u, const std::vector<float>& U) {
+		if (u >= U[n + 1]) {
+			// skip the empty spans at the end
+			int i = n;
+			while (i > p && U[i] >= U[n + 1]) {
+				--i;
+			}
+			return i;
+		}
+		if (u <= U[p]) {
+			// skip the empty spans at the beginning
+			int i = p;
+			while (i < n && U[i + 1] <= U[p]) {
+				++i;
+			}
+			return i;
+		}
+		int low = p;
+		int high = n + 1;
+		int mid = (low + high) / 2;
+		while (u < U[mid] || u >= U[mid + 1]) {
+			if (u < U[mid]) {
+				high = mid;
+			}
+			else {
+				low = mid;
+			}
+			mid = (low + high) / 2;
+		}
+		return mid;
+	}
+
+	/**
+	 * @brief Clamped knot vector with uniformly spaced inner knots on [start, end] for count control points.
+	 */
+	inline std::vector<float> ClampedUniformKnots(int count, int p, float start = 0.f, float end = 1.f) {
+		std::vector<float> U(count + p + 1);
+		int spans = count - p;
+		for (int i = 0; i < U.size(); ++i) {
+			int k = glm::clamp(i - p, 0, spans);
+			U[i] = glm::mix(start, end, float(k) / float(spans));
+		}
+		return U;
+	}
+
+	/**
+	 * @brief Knot vector of a closed curve with N = breaks.size() - 1 distinct control points.
+	 * The domain [U[p], U[N+p]] is divided at breaks, and the knot spacing repeats with the period
+	 * breaks.back() - breaks.front() on both sides. The curve is evaluated with the control points
+	 * P_0 ... P_{N-1}, P_0 ... P_{p-1}, see WrapCtrlPoints.
+	 */
+	inline std::vector<float> PeriodicKnots(const std::vector<float>& breaks, int p) {
+		int N = breaks.size() - 1;
+		float period = breaks.back() - breaks.front();
+		std::vector<float> U(N + 2 * p + 1);
+		for (int i = 0; i < U.size(); ++i) {
+			int k = i - p;
+			int wraps = k >= 0 ? k / N : -((N - 1 - k) / N);		// floor(k / N)
+			U[i] = breaks[k - wraps * N] + wraps * period;
+		}
+		return U;
+	}
+
+	/**
+	 * @brief Periodic knot vector with a uniformly divided domain [start, end] for count distinct control points.
+	 */
+	inline std::vector<float> PeriodicUniformKnots(int count, int p, float start = 0.f, float end = 1.f) {
+		std::vector<float> breaks(count + 1);
+		for (int i = 0; i <= count; ++i) {
+			breaks[i] = glm::mix(start, end, float(i) / float(count));
+		}
+		return PeriodicKnots(breaks, p);
+	}
+
+	/**
+	 * @brief Control points of a closed curve as evaluated: the first p points repeated at the end.
+	 */
+	inline std::vector<glm::vec4> WrapCtrlPoints(const std::vector<glm::vec4>& P, int p) {
+		std::vector<glm::vec4> wrapped = P;
+		for (int i = 0; i < p && !P.empty(); ++i) {
+			wrapped.push_back(P[i % P.size()]);
+		}
+		return wrapped;
+	}
+
+	/**
+	 * @brief BasisFuns for a fixed degree, the loops have constant bounds and the work arrays live on the stack.
+	 */
+	template <int P>
+	inline void BasisFunsFixed(int i, float u, const std::vector<float>& U, float* N) {
+		float left[P + 1];
+		float right[P + 1];
+		N[0] = 1.f;
+		for (int j = 1; j <= P; ++j) {
+			left[j] = u - U[i + 1 - j];
+			right[j] = U[i + j] - u;
+			float saved = 0.f;
+			for (int r = 0; r < j; ++r) {
+				float temp = N[r] / (right[r + 1] + left[j - r]);
+				N[r] = saved + right[r + 1] * temp;
+				saved = left[j - r] * temp;
+			}
+			N[j] = saved;
+		}
+	}
+
+	/**
+	 * @brief The p + 1 nonvanishing basis functions N[0..p] = N_{i-p..i,p}(u) of the span i (A2.2).
+	 * Degrees up to MAX_DEGREE run the specialized kernel.
+	 */
+	inline void BasisFuns(int i, float u, int p, const std::vector<float>& U, float* N) {
+		switch (p) {
+		case 1: BasisFunsFixed<1>(i, u, U, N); return;
+		case 2: BasisFunsFixed<2>(i, u, U, N); return;
+		case 3: BasisFunsFixed<3>(i, u, U, N); return;
+		case 4: BasisFunsFixed<4>(i, u, U, N); return;
+		case 5: BasisFunsFixed<5>(i, u, U, N); return;
+		case 6: BasisFunsFixed<6>(i, u, U, N); return;
+		case 7: BasisFunsFixed<7>(i, u, U, N); return;
+		}
+		std::vector<float> left(p + 1);
+		std::vector<float> right(p + 1);
+		N[0] = 1.f;
+		for (int j = 1; j <= p; ++j) {
+			left[j] = u - U[i + 1 - j];
+			right[j] = U[i + j] - u;
+			float saved = 0.f;
+			for (int r = 0; r < j; ++r) {
+				float temp = N[r] / (right[r + 1] + left[j - r]);
+				N[r] = saved + right[r + 1] * temp;
+				saved = left[j - r] * temp;
+			}
+			N[j] = saved;
+		}
+	}
+
+	/**
+	 * @brief Floats of work memory DersBasisFuns needs for degree p.
+	 */
+	constexpr int DersScratchSize(int p) {
+		return (p + 1) * (p + 1) + 4 * (p + 1);
+	}
+
+	/**
+	 * @brief The nonvanishing basis functions of the span i and their derivatives up to order d (A2.3).
+	 * ders is (d + 1) x (p + 1) row-major, ders[k * (p + 1) + j] is the k-th derivative of N_{i-p+j,p}(u).
+	 * Derivatives above the degree are zero.
+	 * @param scratch work memory of DersScratchSize(p) floats, so repeated calls do not allocate.
+	 */
+	inline void DersBasisFuns(int i, float u, int p, int d, const std::vector<float>& U, float* ders, float* scratch) {
+		int w = p + 1;
+		float* ndu = scratch;				// basis functions (upper triangle) and knot differences (lower triangle)
+		float* left = ndu + w * w;
+		float* right = left + w;
+		float* a = right + w;				// two alternating rows of the coefficients a_{k,j}
+		ndu[0] = 1.f;
+		for (int j = 1; j <= p; ++j) {
+			left[j] = u - U[i + 1 - j];
+			right[j] = U[i + j] - u;
+			float saved = 0.f;
+			for (int r = 0; r < j; ++r) {
+				ndu[j * w + r] = right[r + 1] + left[j - r];
+				float temp = ndu[r * w + j - 1] / ndu[j * w + r];
+				ndu[r * w + j] = saved + right[r + 1] * temp;
+				saved = left[j - r] * temp;
+			}
+			ndu[j * w + j] = saved;
+		}
+		for (int j = 0; j <= p; ++j) {
+			ders[j] = ndu[j * w + p];
+		}
+		for (int k = p + 1; k <= d; ++k) {
+			std::fill(ders + k * w, ders + (k + 1) * w, 0.f);
+		}
+
+		for (int r = 0; r <= p; ++r) {
+			int s1 = 0;
+			int s2 = 1;
+			a[0] = 1.f;
+			for (int k = 1; k <= glm::min(d, p); ++k) {
+				float value = 0.f;
+				int rk = r - k;
+				int pk = p - k;
+				if (r >= k) {
+					a[s2 * w] = a[s1 * w] / ndu[(pk + 1) * w + rk];
+					value = a[s2 * w] * ndu[rk * w + pk];
+				}
+				int j1 = rk >= -1 ? 1 : -rk;
+				int j2 = r - 1 <= pk ? k - 1 : p - r;
+				for (int j = j1; j <= j2; ++j) {
+					a[s2 * w + j] = (a[s1 * w + j] - a[s1 * w + j - 1]) / ndu[(pk + 1) * w + rk + j];
+					value += a[s2 * w + j] * ndu[(rk + j) * w + pk];
+				}
+				if (r <= pk) {
+					a[s2 * w + k] = -a[s1 * w + k - 1] / ndu[(pk + 1) * w + r];
+					value += a[s2 * w + k] * ndu[r * w + pk];
+				}
+				ders[k * w + r] = value;
+				std::swap(s1, s2);
+			}
+		}
+
+		// multiply by p! / (p - k)!
+		float factor = float(p);
+		for (int k = 1; k <= glm::min(d, p); ++k) {
+			for (int j = 0; j <= p; ++j) {
+				ders[k * w + j] *= factor;
+			}
+			factor *= float(p - k);
+		}
+	}
+
+	inline void DersBasisFuns(int i, float u, int p, int d, const std::vector<float>& U, float* ders) {
+		std::vector<float> scratch(DersScratchSize(p));
+		DersBasisFuns(i, u, p, d, U, ders, scratch.data());
+	}
+
+	/**
+	 * @brief Every nonzero basis function N_{first..first+p,p} at one parameter, and optionally their derivatives,
+	 * computed in one pass. Basis functions outside the span read as zero.
+	 */
+	struct BasisRow {
+		int p = 0;
+		int first = 0;				// index of the first nonzero basis function, span - p
+		int order = 0;				// highest derivative stored
+		std::vector<float> ders{};	// (order + 1) x (p + 1), see DersBasisFuns
+
+		/**
+		 * @brief k-th derivative of N_{i,p} at the parameter of the row.
+		 */
+		inline float operator()(int i, int k = 0) const {
+			if (i < first || i > first + p || k > order) {
+				return 0.f;
+			}
+			return ders[k * (p + 1) + i - first];
+		}
+	};
+
+	/**
+	 * @brief Nonzero basis functions of degree p at u, with derivatives up to order d.
+	 */
+	inline BasisRow EvaluateBasis(int p, float u, const std::vector<float>& U, int d = 0) {
+		BasisRow row;
+		int n = U.size() - p - 2;
+		int span = FindSpan(n, p, u, U);
+		row.p = p;
+		row.first = span - p;
+		row.order = d;
+		row.ders.resize((d + 1) * (p + 1));
+		if (d == 0) {
+			BasisFuns(span, u, p, U, row.ders.data());
+		}
+		else {
+			DersBasisFuns(span, u, p, d, U, row.ders.data());
+		}
+		return row;
+	}
+
+	/**
+	 * @brief CurvePoint for a fixed degree, without heap allocation.
+	 */
+	template <int P>
+	inline glm::vec4 CurvePointFixed(const std::vector<float>& U, const std::vector<glm::vec4>& ctrlPoints, float u) {
+		int n = ctrlPoints.size() - 1;
+		int span = FindSpan(n, P, u, U);
+		float N[P + 1];
+		BasisFunsFixed<P>(span, u, U, N);
+		glm::vec4 C(0);
+		for (int j = 0; j <= P; ++j) {
+			C += N[j] * ctrlPoints[span - P + j];
+		}
+		return C;
+	}
+
+	/**
+	 * @brief Point of the curve at u (A3.1).
+	 */
+	inline glm::vec4 CurvePoint(int p, const std::vector<float>& U, const std::vector<glm::vec4>& P, float u) {
+		switch (p) {
+		case 1: return CurvePointFixed<1>(U, P, u);
+		case 2: return CurvePointFixed<2>(U, P, u);
+		case 3: return CurvePointFixed<3>(U, P, u);
+		case 4: return CurvePointFixed<4>(U, P, u);
+		case 5: return CurvePointFixed<5>(U, P, u);
+		case 6: return CurvePointFixed<6>(U, P, u);
+		case 7: return CurvePointFixed<7>(U, P, u);
+		}
+		int n = P.size() - 1;
+		int span = FindSpan(n, p, u, U);
+		std::vector<float> N(p + 1);
+		BasisFuns(span, u, p, U, N.data());
+		glm::vec4 C(0);
+		for (int j = 0; j <= p; ++j) {
+			C += N[j] * P[span - p + j];
+		}
+		return C;
+	}
+
+	/**
+	 * @brief Number of knots equal to u.
+	 */
+	inline int KnotMultiplicity(const std::vector<float>& U, float u) {
+		int s = 0;
+		for (float knot : U) {
+			if (std::abs(knot - u) < EPSILON) {
+				++s;
+			}
+		}
+		return s;
+	}
+
+	/**
+	 * @brief Inserts u into the knot vector once without changing the shape of the curve (Boehm, A5.1).
+	 */
+	inline void InsertKnot(int p, std::vector<float>& U, std::vector<glm::vec4>& P, float u) {
+		int n = P.size() - 1;
+		int k = FindSpan(n, p, u, U);
+
+		std::vector<glm::vec4> Q(n + 2);
+		for (int i = 0; i <= k - p; ++i) {
+			Q[i] = P[i];
+		}
+		for (int i = k - p + 1; i <= k; ++i) {
+			float denom = U[i + p] - U[i];
+			float alpha = denom > EPSILON ? (u - U[i]) / denom : 0.f;
+			Q[i] = alpha * P[i] + (1.f - alpha) * P[i - 1];
+		}
+		for (int i = k + 1; i <= n + 1; ++i) {
+			Q[i] = P[i - 1];
+		}
+
+		U.insert(U.begin() + k + 1, u);
+		P = std::move(Q);
+	}
+
+	/**
+	 * @brief Inserts the sorted knots X in one pass without changing the shape of the curve (A5.4).
+	 * Cheaper than inserting them one by one, every new control point is computed once like in the Oslo algorithm.
+	 */
+	inline void RefineKnotVector(int p, std::vector<float>& U, std::vector<glm::vec4>& P, const std::vector<float>& X) {
+		if (X.empty()) {
+			return;
+		}
+		int n = P.size() - 1;
+		int m = n + p + 1;
+		int r = X.size() - 1;
+		int a = FindSpan(n, p, X[0], U);
+		int b = FindSpan(n, p, X[r], U) + 1;
+
+		std::vector<glm::vec4> Q(n + r + 2);
+		std::vector<float> Ubar(m + r + 2);
+		for (int j = 0; j <= a - p; ++j) {
+			Q[j] = P[j];
+		}
+		for (int j = b - 1; j <= n; ++j) {
+			Q[j + r + 1] = P[j];
+		}
+		for (int j = 0; j <= a; ++j) {
+			Ubar[j] = U[j];
+		}
+		for (int j = b + p; j <= m; ++j) {
+			Ubar[j + r + 1] = U[j];
+		}
+
+		int i = b + p - 1;
+		int k = b + p + r;
+		for (int j = r; j >= 0; --j) {
+			while (X[j] <= U[i] && i > a) {
+				Q[k - p - 1] = P[i - p - 1];
+				Ubar[k] = U[i];
+				--k;
+				--i;
+			}
+			Q[k - p - 1] = Q[k - p];
+			for (int l = 1; l <= p; ++l) {
+				int ind = k - p + l;
+				float alpha = Ubar[k + l] - X[j];
+				if (std::abs(alpha) < EPSILON) {
+					Q[ind - 1] = Q[ind];
+				}
+				else {
+					alpha /= Ubar[k + l] - U[i - p + l];
+					Q[ind - 1] = alpha * Q[ind - 1] + (1.f - alpha) * Q[ind];
+				}
+			}
+			Ubar[k] = X[j];
+			--k;
+		}
+
+		U = std::move(Ubar);
+		P = std::move(Q);
+	}
+
+	/**
+	 * @brief Control points P[r-p ... r-s] after removing the interior knot U[r] (the last of its s copies) once,
+	 * computed from both ends (A5.8). The curve moves at most the returned distance.
+	 * @param temp receives the new control points, temp[1 ...] replaces P[r-p ...].
+	 */
+	inline float KnotRemovalError(int p, const std::vector<float>& U, const std::vector<glm::vec4>& P, int r, int s, std::vector<glm::vec4>& temp) {
+		float u = U[r];
+		int first = r - p;
+		int last = r - s;
+		int off = first - 1;
+		temp.assign(last - off + 2, glm::vec4(0));
+		temp[0] = P[off];
+		temp[last + 1 - off] = P[last + 1];
+
+		int i = first;
+		int j = last;
+		int ii = 1;
+		int jj = last - off;
+		while (j - i > 0) {
+			float alphaI = (u - U[i]) / (U[i + p + 1] - U[i]);
+			float alphaJ = (u - U[j]) / (U[j + p + 1] - U[j]);
+			temp[ii] = (P[i] - (1.f - alphaI) * temp[ii - 1]) / alphaI;
+			temp[jj] = (P[j] - alphaJ * temp[jj + 1]) / (1.f - alphaJ);
+			++i;
+			++ii;
+			--j;
+			--jj;
+		}
+		if (j - i < 0) {
+			return glm::distance(temp[ii - 1], temp[jj + 1]);
+		}
+		float alphaI = (u - U[i]) / (U[i + p + 1] - U[i]);
+		return glm::distance(P[i], alphaI * temp[ii + 1] + (1.f - alphaI) * temp[ii - 1]);
+	}
+
+	/**
+	 * @brief Removes the interior knot U[r] (the last of its s copies) once with the control points of KnotRemovalError.
+	 */
+	inline void RemoveKnot(int p, std::vector<float>& U, std::vector<glm::vec4>& P, int r, int s, const std::vector<glm::vec4>& temp) {
+		int first = r - p;
+		int last = r - s;
+		int off = first - 1;
+		for (int i = first, j = last; j - i > 0; ++i, --j) {
+			P[i] = temp[i - off];
+			P[j] = temp[j - off];
+		}
+		// the two halves overlap in P[(first + last) / 2]
+		P.erase(P.begin() + (first + last) / 2);
+		U.erase(U.begin() + r);
+	}
+
+	/**
+	 * @brief Removes as many interior knots as possible while the curve stays within tolerance of the original one.
+	 * The bounds of the single removals are summed up over the spans of the original knot vector
+	 * they affect, a knot is only removed if the sum stays below tolerance everywhere.
+	 * @return number of removed knots.
+	 */
+	inline int RemoveKnots(int p, std::vector<float>& U, std::vector<glm::vec4>& P, float tolerance) {
+		if (!IsValid(p, U, P)) {
+			Log::errorToConsole("BSplineAlgorithms::RemoveKnots knot vector does not match the control points");
+			return 0;
+		}
+		// accumulated error on the spans between the distinct knots of the original curve
+		std::vector<float> breaks;
+		for (float knot : U) {
+			if (breaks.empty() || knot - breaks.back() > EPSILON) {
+				breaks.push_back(knot);
+			}
+		}
+		std::vector<float> errors(breaks.size(), 0.f);
+		auto spanRange = [&](float from, float to, int& begin, int& end) {
+			begin = std::upper_bound(breaks.begin(), breaks.end(), from + EPSILON) - breaks.begin() - 1;
+			end = std::lower_bound(breaks.begin(), breaks.end(), to - EPSILON) - breaks.begin();
+		};
+
+		int removed = 0;
+		std::vector<glm::vec4> temp;
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			int r = p + 1;
+			while (r < P.size()) {
+				// r is the last copy of an interior knot with multiplicity s
+				if (U[r + 1] - U[r] <= EPSILON) {
+					++r;
+					continue;
+				}
+				int s = 1;
+				while (r - s > p && U[r] - U[r - s] <= EPSILON) {
+					++s;
+				}
+				if (s > p) {
+					++r;
+					continue;
+				}
+				float error = KnotRemovalError(p, U, P, r, s, temp);
+				// the changed control points P[r-p ... r-s] are nonzero on [U[r-p], U[r-s+p+1]]
+				int begin, end;
+				spanRange(U[r - p], U[r - s + p + 1], begin, end);
+				float worst = 0.f;
+				for (int i = begin; i < end; ++i) {
+					worst = glm::max(worst, errors[i]);
+				}
+				if (worst + error > tolerance) {
+					++r;
+					continue;
+				}
+				for (int i = begin; i < end; ++i) {
+					errors[i] += error;
+				}
+				RemoveKnot(p, U, P, r, s, temp);
+				++removed;
+				changed = true;
+				// r now points after the remaining copies
+			}
+		}
+		return removed;
+	}
+
+	/**
+	 * @brief Bezier control points of the nonempty span [U[i], U[i+1]), i in [p, n].
+	 * Only the curve of P[i-p..i] over U[i-p..i+p+1] is refined: both ends of the span are inserted until their
+	 * multiplicity reaches p, so a span costs O(p^3) independent of the size of the curve.
+	 */
+	inline std::vector<glm::vec4> SpanToBezier(int p, const std::vector<float>& U, const std::vector<glm::vec4>& P, int i) {
+		std::vector<float> localU(U.begin() + (i - p), U.begin() + (i + p + 2));
+		std::vector<glm::vec4> localP(P.begin() + (i - p), P.begin() + (i + 1));
+		float a = U[i];
+		float b = U[i + 1];
+		for (int s = KnotMultiplicity(localU, a); s < p; ++s) {
+			InsertKnot(p, localU, localP, a);
+		}
+		for (int s = KnotMultiplicity(localU, b); s < p; ++s) {
+			InsertKnot(p, localU, localP, b);
+		}
+		int k = FindSpan(localP.size() - 1, p, 0.5f * (a + b), localU);
+		return std::vector<glm::vec4>(localP.begin() + (k - p), localP.begin() + (k + 1));
+	}
+
+	/**
+	 * @brief Splits the curve into Bezier segments of degree p, one for each nonempty span of the domain [U[p], U[n+1]].
+	 */
+	inline std::vector<std::vector<glm::vec4>> DecomposeToBezier(int p, const std::vector<float>& U, const std::vector<glm::vec4>& P) {
+		std::vector<std::vector<glm::vec4>> segments;
+		if (!IsValid(p, U, P)) {
+			Log::errorToConsole("BSplineAlgorithms::DecomposeToBezier knot vector does not match the control points");
+			return segments;
+		}
+
+		int n = P.size() - 1;
+		for (int i = p; i <= n; ++i) {
+			if (U[i + 1] - U[i] > EPSILON) {
+				segments.push_back(SpanToBezier(p, U, P, i));
+			}
+		}
+		return segments;
+	}
+}
\ No newline at end of file
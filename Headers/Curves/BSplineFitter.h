@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Least-squares B-Spline approximation of a point stream with a fixed number of control points.
+ * The knot vector is clamped and uniform on [start, end], every point is added with its parameter and only
+ * updates the banded normal equations (N^T N) P = N^T Q, so the points never have to be kept in memory.
+ * Solve factors the normal equations with banded Cholesky in O(ctrlPointCount * degree^2).
+ *
+ * Parameter correction (Hoschek): after Solve, BeginCorrection keeps the solution and clears the equations.
+ * The same points are streamed again with the same parameters, and each parameter is moved along the tangent
+ * of every kept curve towards its foot point before it is added. Each pass trades fit time for accuracy.
+ */
+class BSplineFitter {
+protected:
+	int m_degree = 3;
+	std::vector<float> m_knots{};
+	BandedSystem::SymmetricBandedMatrix m_normal{};		// N^T N
+	std::vector<glm::dvec4> m_rhs{};					// N^T Q
+	size_t m_pointCount = 0;
+	float m_smoothing = 0.f;
+	std::vector<std::vector<glm::vec4>> m_corrections{};	// curves of the previous passes
+	std::vector<float> m_basis{};
+	std::vector<float> m_ders{};			// basis and first derivatives of a parameter correction
+	std::vector<float> m_dersScratch{};		// work memory of DersBasisFuns, reused for every point
+
+	float CorrectParam(const glm::vec4& point, float t);
+
+public:
+	BSplineFitter() = default;
+	/**
+	 * @param ctrlPointCount number of control points of the fitted curve, at least degree + 1
+	 * @param start, end parameter domain, the parameters of the added points have to be inside it
+	 */
+	BSplineFitter(int ctrlPointCount, int degree, float start = 0.f, float end = 1.f);
+
+	/**
+	 * @brief Weight of a second difference penalty sum |P_{i-1} - 2 P_i + P_{i+1}|^2.
+	 * Keeps the system solvable if some knot spans receive no points.
+	 */
+	inline void SetSmoothing(float smoothing) {
+		m_smoothing = glm::max(smoothing, 0.f);
+	}
+	inline float GetSmoothing() const {
+		return m_smoothing;
+	}
+
+	/**
+	 * @brief Adds one point of the stream at parameter t, after the parameter corrections of the previous passes.
+	 */
+	void AddPoint(const glm::vec4& point, float t, float weight = 1.f);
+	void AddPoints(const glm::vec4* points, const float* params, size_t count);
+
+	inline size_t GetPointCount() const {
+		return m_pointCount;
+	}
+	inline int GetDegree() const {
+		return m_degree;
+	}
+	inline const std::vector<float>& GetKnots() const {
+		return m_knots;
+	}
+	inline int GetCorrectionCount() const {
+		return m_corrections.size();
+	}
+
+	/**
+	 * @brief Control points of the least-squares curve.
+	 * @return false if the system is singular (too few points, or knot spans without points and no smoothing).
+	 */
+	bool Solve(std::vector<glm::vec4>& ctrlPoints) const;
+	/**
+	 * @brief Starts a parameter correction pass with the given solution, the points have to be added again.
+	 */
+	void BeginCorrection(const std::vector<glm::vec4>& ctrlPoints);
+	/**
+	 * @brief Clears the normal equations and the corrections.
+	 */
+	void Reset();
+};
@@ -19,54 +19,50 @@ namespace BSplineInterpolation {
         return vec / scalar;
     }
 
-
-    // ----------------------------------------------------------------------
-    // 1. COX-DE BOOR FGGVNY (N_{i,p}(t)) - ROBUST VERZI
-    // ----------------------------------------------------------------------
-
     /**
-     * @brief A robusztus Cox-de Boor algoritmus a B-Spline alapfggvnyekhez.
-     * Ez a verzi expliciten kezeli a $0/0$ eseteket (amelyek a Clamped vgpontoknl jelentkeznek)
-     * a $p>0$ rekurziban.
+     * @brief The w of a data point is the weight of the curve at that point, 1 for a polynomial curve.
+     * The system is solved for the homogeneous data points (w x, w y, w z, w), so the control points come out
+     * homogeneous and the rational curve passes through the Cartesian points.
+     * @param cartesian receives the data points with w = 1, these are the interpolated points of the curve.
+     * @return false if a weight is not positive.
      */
-    inline float CoxDeBoor(int i, int p, float t, const std::vector<float>& U) {
-        // Alap eset: p=0 (szakaszos konstans fggvny)
-        if (p == 0) {
-            // A B-Spline definci szerint az N_i,0(t) = 1, ha U_i <= t < U_{i+1}.
-            // Mivel Clamped spline-t hasznlunk, a t=1.0 vgpontot is tartalmaznia kell az utols N-nek.
-            if (U[i] <= t && t < U[i + 1]) {
-                return 1.0f;
-            }
-            // Specilis kezels a t=1.0 vgpontra (Csak akkor hvdik, ha t=1.0)
-            // t=1.0 esetn N_{N-1,p}(1.0)=1.0, a tbbi N_{i,p}(1.0)=0.0.
-            // A rekurzi sorn N_{N-1,p}(1.0) a p=0 szinten az U.size()-2 index intervallumot ri el.
-            if (i == U.size() - 2 && std::abs(t - 1.0f) < EPSILON) {
-                return 1.0f;
+    inline bool HomogenizeDataPoints(const std::vector<glm::vec4>& dataPoints, std::vector<glm::vec4>& homogeneous, std::vector<glm::vec4>& cartesian) {
+        homogeneous.resize(dataPoints.size());
+        cartesian.resize(dataPoints.size());
+        for (int i = 0; i < dataPoints.size(); ++i) {
+            if (dataPoints[i].w <= 0.f) {
+                Log::errorToConsole("Interpolation error: the weight (w) of data point ", i, " is not positive.");
+                return false;
             }
-            return 0.0f;
+            cartesian[i] = glm::vec4(glm::vec3(dataPoints[i]), 1.f);
+            homogeneous[i] = BezierAlgorithms::Homogenize(glm::vec3(dataPoints[i]), dataPoints[i].w);
         }
+        return true;
+    }
 
-        // --- Bal Oldali Tag: (t - U[i]) / (U[i + p] - U[i]) * N_{i, p-1}(t) ---
-        float leftTerm = 0.0f;
-        float denomLeft = U[i + p] - U[i];
-
-        // Elkerljk a 0/0 esetet: Ha a nevez 0, a tag rtke 0.
-        if (denomLeft > EPSILON) {
-            float numLeft = t - U[i];
-            leftTerm = (numLeft / denomLeft) * CoxDeBoor(i, p - 1, t, U);
+    /**
+     * @brief Rounding leaves the weights of a polynomial interpolant slightly off 1, they are reset.
+     */
+    inline void FixPolynomialWeights(const std::vector<glm::vec4>& dataPoints, std::vector<glm::vec4>& ctrlPoints) {
+        if (BezierAlgorithms::IsRational(dataPoints)) {
+            return;
         }
+        for (auto& point : ctrlPoints) {
+            point.w = 1.f;
+        }
+    }
 
-        // --- Jobb Oldali Tag: (U[i + p + 1] - t) / (U[i + p + 1] - U[i + 1]) * N_{i + 1, p-1}(t) ---
-        float rightTerm = 0.0f;
-        float denomRight = U[i + p + 1] - U[i + 1];
 
-        // Elkerljk a 0/0 esetet: Ha a nevez 0, a tag rtke 0.
-        if (denomRight > EPSILON) {
-            float numRight = U[i + p + 1] - t;
-            rightTerm = (numRight / denomRight) * CoxDeBoor(i + 1, p - 1, t, U);
-        }
+    // ----------------------------------------------------------------------
+    // 1. COX-DE BOOR FGGVNY (N_{i,p}(t)) - ROBUST VERZI
+    // ----------------------------------------------------------------------
 
-        return leftTerm + rightTerm;
+    /**
+     * @brief N_{i,p}(t), read from the span-based basis evaluation (BSplineAlgorithms::EvaluateBasis).
+     * Evaluating a whole row with EvaluateBasis is cheaper when several basis functions are needed at the same t.
+     */
+    inline float CoxDeBoor(int i, int p, float t, const std::vector<float>& U) {
+        return BSplineAlgorithms::EvaluateBasis(p, t, U)(i);
     }
 
 
@@ -74,25 +70,27 @@ namespace BSplineInterpolation {
     // 2. CSOMVEKTOR GENERLSA (U)
     // ----------------------------------------------------------------------
 
+    /**
+     * @brief Clamped knot vector for interpolating N points with degree p, the inner knots average
+     * p consecutive parameters (The NURBS Book, eq. 9.8). Every row of the collocation matrix then has
+     * its nonzeros around the diagonal, and the matrix is banded with bandwidth below p.
+     */
     inline std::vector<float> GenerateKnotVector(int N, int p, const std::vector<float>& t_values) {
-        int M_plus_1 = N + p + 1;
-        std::vector<float> U(M_plus_1);
+        std::vector<float> U(N + p + 1);
 
-        // 1. Els p+1 csom 0.0 (Clamped)
+        // Clamped ends
         for (int i = 0; i <= p; ++i) {
             U[i] = 0.0f;
+            U[N + i] = 1.0f;
         }
 
-        // 2. Bels csomk: U_{j} = t_{j-p}
-        // U index: p+1-tl N-1-ig. (t index: 1-tl N-p-1-ig)
-        for (int j = p + 1; j < N; ++j) {
-            // Ezzel U_{p+1} = t_1, ..., U_{N-1} = t_{N-p-1}
-            U[j] = t_values[j - p];
-        }
-
-        // 3. Utols p+1 csom 1.0 (Clamped)
-        for (int i = N; i < M_plus_1; ++i) {
-            U[i] = 1.0f;
+        // Inner knots: U_{j+p} = (t_j + ... + t_{j+p-1}) / p
+        for (int j = 1; j < N - p; ++j) {
+            float sum = 0.0f;
+            for (int i = j; i < j + p; ++i) {
+                sum += t_values[i];
+            }
+            U[j + p] = sum / p;
         }
 
         return U;
@@ -146,11 +144,80 @@ namespace BSplineInterpolation {
         return P;
     }
 
+    /**
+     * @brief Cyclic tridiagonal system: the tridiagonal a, b, c plus the corners alpha = A(N-1, 0)
+     * and beta = A(0, N-1). The corners are a rank one update of a tridiagonal matrix, so with
+     * Sherman-Morrison the solution takes two passes of SolveInterpolation, O(N) in total.
+     */
+    inline std::vector<glm::vec4> SolveCyclicInterpolation(
+        const std::vector<float>& a,
+        const std::vector<float>& b,
+        const std::vector<float>& c,
+        float alpha,
+        float beta,
+        const std::vector<glm::vec4>& D,
+        int N
+    ) {
+        if (N < 3) {
+            Log::errorToConsole("Interpolation failure: the cyclic system needs at least 3 rows.");
+            return {};
+        }
+
+        // A = T + u v^T with u = (gamma, 0, ..., 0, alpha), v = (1, 0, ..., 0, beta / gamma)
+        float gamma = -b[0];
+        std::vector<float> bb = b;
+        bb[0] = b[0] - gamma;
+        bb[N - 1] = b[N - 1] - alpha * beta / gamma;
+
+        std::vector<glm::vec4> x = SolveInterpolation(a, bb, c, D, N);
+        std::vector<glm::vec4> u(N, glm::vec4(0));
+        u[0] = glm::vec4(gamma);
+        u[N - 1] = glm::vec4(alpha);
+        std::vector<glm::vec4> z = SolveInterpolation(a, bb, c, u, N);
+        if (x.empty() || z.empty()) {
+            return {};
+        }
+
+        // x - z (v.x) / (1 + v.z)
+        glm::vec4 factor = (x[0] + beta * x[N - 1] / gamma) / (1.0f + z[0] + beta * z[N - 1] / gamma);
+        for (int i = 0; i < N; ++i) {
+            x[i] -= factor * z[i];
+        }
+        return x;
+    }
+
 
     // ----------------------------------------------------------------------
-    // 4. CORE INTERPOLCIS LOGIKA ((N-2)x(N-2) RENDSZER)
+    // 4. CORE INTERPOLCIS LOGIKA (NxN SVOS RENDSZER)
     // ----------------------------------------------------------------------
 
+    /**
+     * @brief Banded collocation matrix A(i, j) = N_{j,p}(t_i) of the knot vector U.
+     */
+    inline BandedSystem::BandedMatrix CollocationMatrix(int p, const std::vector<float>& t_values, const std::vector<float>& U) {
+        int N = t_values.size();
+
+        // bandwidths from the spans of the parameters
+        std::vector<int> spans(N);
+        int lower = 0;
+        int upper = 0;
+        for (int i = 0; i < N; ++i) {
+            spans[i] = BSplineAlgorithms::FindSpan(N - 1, p, t_values[i], U);
+            lower = glm::max(lower, i - (spans[i] - p));
+            upper = glm::max(upper, spans[i] - i);
+        }
+
+        BandedSystem::BandedMatrix A(N, lower, upper);
+        std::vector<float> basis(p + 1);
+        for (int i = 0; i < N; ++i) {
+            BSplineAlgorithms::BasisFuns(spans[i], t_values[i], p, U, basis.data());
+            for (int k = 0; k <= p; ++k) {
+                A(i, spans[i] - p + k) = basis[k];
+            }
+        }
+        return A;
+    }
+
     inline BSpline* CoreInterpolation(
         int N,
         const std::vector<glm::vec4>& dataPoints,
@@ -163,87 +230,126 @@ namespace BSplineInterpolation {
             return nullptr;
         }
 
-        int N_sys = N - 2;
+        // --- STEP 1: Generate Knot Vector (U) ---
+        std::vector<float> U = GenerateKnotVector(N, p, t_values);
 
-        if (N_sys <= 0) {
-            Log::errorToConsole("Interpolation error: System size is too small (N-2 <= 0).");
+        // --- STEP 2: Setup Linear System (A * P = Q) ---
+        // Every data point gives one row, the first and the last row pin the end points.
+        BandedSystem::BandedMatrix A = CollocationMatrix(p, t_values, U);
+        std::vector<glm::vec4> Q, interpolatedPoints;
+        if (!HomogenizeDataPoints(dataPoints, Q, interpolatedPoints)) {
             return nullptr;
         }
 
-        // --- STEP 1: Generate Knot Vector (U) ---
-        std::vector<float> U = GenerateKnotVector(N, p, t_values);
-
-        // --- STEP 2: Setup Linear System (A * P_{internal} = D_{modified}) ---
+        // --- STEP 3: Solve the System (Banded LU, all four channels at once) ---
+        if (!BandedSystem::FactorLU(A)) {
+            Log::errorToConsole("Interpolation failure: the collocation matrix is singular.");
+            return nullptr;
+        }
+        std::vector<glm::vec4> P_ctrlPoints = Q;
+        BandedSystem::SolveLU(A, P_ctrlPoints);
+        FixPolynomialWeights(dataPoints, P_ctrlPoints);
 
-        std::vector<float> a(N_sys);
-        std::vector<float> b(N_sys);
-        std::vector<float> c(N_sys);
-        std::vector<glm::vec4> D_modified(N_sys);
+        // --- STEP 4: Create BSpline Object ---
+        BSpline* newSpline = new BSpline(params);
+        newSpline->SetCtrlPoints(P_ctrlPoints);
+        newSpline->SetInterpolatedPoints(interpolatedPoints);
+        newSpline->SetKnots(U);
 
-        const glm::vec4& Q0 = dataPoints.front();
-        const glm::vec4& QN_1 = dataPoints.back();
+        return newSpline;
+    }
 
-        // Ciklus az interpolland adatpontokon: Q_1-tl Q_{N-2}-ig.
-        for (int i = 1; i <= N - 2; ++i) {
-            int j = i - 1; // Mtrix sor indexe: 0-tl N_sys-1-ig.
-            float t_i = t_values[i]; // Paramterrtk Q_i-hez.
 
-            // a[j] (Sub-diagonal): N_{i-1, p}(t_i)
-            a[j] = CoxDeBoor(i - 1, p, t_i, U);
-            if (j == 0) a[j] = 0.0f;
+    // ----------------------------------------------------------------------
+    // 4/B. ZRT (PERIODIKUS) GRBE INTERPOLCIJA
+    // ----------------------------------------------------------------------
 
-            // b[j] (Main-diagonal): N_{i, p}(t_i)
-            b[j] = CoxDeBoor(i, p, t_i, U);
+    /**
+     * @brief Interpolates the closed loop Q_0 ... Q_{N-1} with a periodic B-Spline.
+     * t_values has N + 1 values, the last one closes the loop. For odd degrees the knots are the parameters,
+     * for even degrees the midpoints between them, so every row of the collocation matrix is centered on its
+     * data point. The cubic system is cyclic tridiagonal and is solved with SolveCyclicInterpolation,
+     * the other degrees with the periodic banded LU.
+     */
+    inline BSpline* PeriodicInterpolation(
+        int N,
+        const std::vector<glm::vec4>& dataPoints,
+        const std::vector<float>& t_values,
+        int p,
+        BSplineParams params
+    ) {
+        if (N < 3 || N < p + 1) {
+            Log::errorToConsole("Interpolation error: Need at least ", glm::max(3, p + 1), " data points for a closed degree ", p, " B-Spline.");
+            return nullptr;
+        }
 
-            // Ha a ftl elem tl kicsi, ez szingularitsra utal!
-            if (b[j] < EPSILON) {
-                Log::errorToConsole("CRITICAL ERROR: Main diagonal element b[", j, "] (N_{", i, ",", p, "}(t_", i, ")) is near zero (", b[j], "). Matrix is ill-conditioned.");
+        // --- STEP 1: Periodic knot vector ---
+        std::vector<float> breaks = t_values;
+        if (p % 2 == 0) {
+            float period = t_values[N] - t_values[0];
+            breaks[0] = 0.5f * (t_values[N - 1] - period + t_values[0]);
+            for (int i = 1; i <= N; ++i) {
+                breaks[i] = 0.5f * (t_values[i - 1] + t_values[i]);
             }
+        }
+        std::vector<float> U = BSplineAlgorithms::PeriodicKnots(breaks, p);
+
+        // --- STEP 2: Collocation rows ---
+        // t_i lies in the span p + i, its basis functions belong to the control points i ... i + p (mod N).
+        // Unknown k is control point k + shift, which moves the nonzeros of row i around the diagonal.
+        int shift = p / 2;
+        std::vector<float> basis((p + 1) * N);
+        for (int i = 0; i < N; ++i) {
+            BSplineAlgorithms::BasisFuns(p + i, t_values[i], p, U, basis.data() + i * (p + 1));
+        }
 
-            // c[j] (Super-diagonal): N_{i+1, p}(t_i)
-            c[j] = CoxDeBoor(i + 1, p, t_i, U);
-            if (j == N_sys - 1) c[j] = 0.0f;
-
-            // --- Jobb Oldal (D) Mdosts ---
-            glm::vec4 Di = dataPoints[i]; // Q_i
-
-            // Els egyenlet (i=1): levonjuk P_0 = Q_0 hatst
-            if (i == 1) {
-                // Di = Q_1 - N_{0,p}(t_1) * P_0
-                Di -= CoxDeBoor(0, p, t_i, U) * Q0;
+        // --- STEP 3: Solve the cyclic system ---
+        std::vector<glm::vec4> Q, interpolatedPoints;
+        if (!HomogenizeDataPoints(dataPoints, Q, interpolatedPoints)) {
+            return nullptr;
+        }
+        std::vector<glm::vec4> X;
+        if (p == 3) {
+            // the basis function of control point i + 3 vanishes at its first knot t_i
+            std::vector<float> a(N), b(N), c(N);
+            for (int i = 0; i < N; ++i) {
+                a[i] = basis[i * 4];
+                b[i] = basis[i * 4 + 1];
+                c[i] = basis[i * 4 + 2];
             }
-
-            // Utols egyenlet (i=N-2): levonjuk P_{N-1} = Q_{N-1} hatst
-            if (i == N - 2) {
-                // Di = Q_{N-2} - N_{N-1,p}(t_{N-2}) * P_{N-1}
-                Di -= CoxDeBoor(N - 1, p, t_i, U) * QN_1;
+            float beta = a[0];
+            float alpha = c[N - 1];
+            a[0] = 0.0f;
+            c[N - 1] = 0.0f;
+            X = SolveCyclicInterpolation(a, b, c, alpha, beta, Q, N);
+        }
+        else {
+            BandedSystem::PeriodicBandedMatrix A(N, shift, p - shift);
+            for (int i = 0; i < N; ++i) {
+                for (int k = 0; k <= p; ++k) {
+                    A.At(i, ((i + k - shift) % N + N) % N) += basis[i * (p + 1) + k];
+                }
+            }
+            if (BandedSystem::FactorLU(A)) {
+                X = Q;
+                BandedSystem::SolveLU(A, X);
             }
-
-            D_modified[j] = Di;
         }
-
-        // --- STEP 3: Solve the System (Thomas Algorithm) ---
-        std::vector<glm::vec4> P_internal = SolveInterpolation(a, b, c, D_modified, N_sys);
-
-        if (P_internal.empty()) {
+        if (X.empty()) {
+            Log::errorToConsole("Interpolation failure: the periodic collocation matrix is singular.");
             return nullptr;
         }
 
-        // --- STEP 4: Create Final BSpline Control Point Vector ---
-        std::vector<glm::vec4> P_ctrlPoints;
-        P_ctrlPoints.push_back(Q0); // P_0 = Q_0
-        P_ctrlPoints.insert(P_ctrlPoints.end(), P_internal.begin(), P_internal.end()); // P_1, ..., P_{N-2}
-        P_ctrlPoints.push_back(QN_1); // P_{N-1} = Q_{N-1}
-
-        if (P_ctrlPoints.size() != N) {
-            Log::errorToConsole("Interpolation error: Final control point count mismatch.");
-            return nullptr;
+        // --- STEP 4: Create BSpline Object ---
+        std::vector<glm::vec4> P_ctrlPoints(N);
+        for (int k = 0; k < N; ++k) {
+            P_ctrlPoints[(k + shift) % N] = X[k];
         }
-
-        // --- STEP 5: Create BSpline Object ---
+        FixPolynomialWeights(dataPoints, P_ctrlPoints);
+        params.periodic = true;
         BSpline* newSpline = new BSpline(params);
         newSpline->SetCtrlPoints(P_ctrlPoints);
-        newSpline->SetInterpolatedPoints(dataPoints);
+        newSpline->SetInterpolatedPoints(interpolatedPoints);
         newSpline->SetKnots(U);
 
         return newSpline;
@@ -310,14 +416,22 @@ inline BSpline* BSpline::CreateInterpolatedWithParams(
     BSplineParams params
 ) {
     int N = dataPoints.size();
-    int p = 3; // Cubic B-Spline
+    int p = params.degree;
 
-    if (N != t_values_raw.size()) {
+    if (!params.periodic && N != t_values_raw.size()) {
         Log::errorToConsole("Error in CreateInterpolatedWithParams: dataPoints and t_values must have the same size.");
         return nullptr;
     }
+    if (params.periodic && N + 1 != t_values_raw.size()) {
+        Log::errorToConsole("Error in CreateInterpolatedWithParams: a closed curve needs one more t value than dataPoints.");
+        return nullptr;
+    }
+    if (p < 1 || p > BSplineAlgorithms::MAX_DEGREE) {
+        Log::errorToConsole("Error in CreateInterpolatedWithParams: degree must be between 1 and ", BSplineAlgorithms::MAX_DEGREE, ".");
+        return nullptr;
+    }
     if (N < p + 1) {
-        Log::errorToConsole("Error in CreateInterpolatedWithParams: Need at least ", p + 1, " points for cubic B-Spline.");
+        Log::errorToConsole("Error in CreateInterpolatedWithParams: Need at least ", p + 1, " points for degree ", p, " B-Spline.");
         return nullptr;
     }
 
@@ -342,6 +456,9 @@ inline BSpline* BSpline::CreateInterpolatedWithParams(
     // Ezzel biztostjuk, hogy a CoreInterpolation mindig stabil, 0..1 tartomnyban lv t rtkekkel dolgozzon.
 
     // tadjuk a normalizlt t_values-t
+    if (params.periodic) {
+        return BSplineInterpolation::PeriodicInterpolation(N, dataPoints, normalized_t_values, p, params);
+    }
     return BSplineInterpolation::CoreInterpolation(N, dataPoints, normalized_t_values, p, params);
 }
 
@@ -350,8 +467,130 @@ inline BSpline* BSpline::CreateInterpolated(
     const std::vector<glm::vec4>& dataPoints,
     BSplineParams params
 ) {
+    if (params.periodic) {
+        // a closing point equal to the first one is implied by the loop
+        std::vector<glm::vec4> loop = dataPoints;
+        if (loop.size() > 1 && glm::length(loop.back() - loop.front()) < BSplineInterpolation::EPSILON) {
+            loop.pop_back();
+        }
+        // the chord from the last point back to the first one closes the parameter range
+        std::vector<glm::vec4> closed = loop;
+        if (!loop.empty()) {
+            closed.push_back(loop.front());
+        }
+        std::vector<float> t_values = BSplineInterpolation::CalculateParametricTs(closed, 0.5f);
+        return CreateInterpolatedWithParams(loop, t_values, params);
+    }
+
     // 1. Calculate parameters (t_i) using the Centripetal Chord Length method
     std::vector<float> t_values = BSplineInterpolation::CalculateParametricTs(dataPoints, 0.5f);
 
     return CreateInterpolatedWithParams(dataPoints, t_values, params);
+}
+
+// Implementation of the static method in the BSpline class
+inline BSpline* BSpline::CreateApproximated(
+    const std::vector<glm::vec4>& dataPoints,
+    int ctrlPointCount,
+    BSplineParams params,
+    int correctionSteps
+) {
+    int p = params.degree;
+    if (params.periodic) {
+        Log::errorToConsole("Error in CreateApproximated: closed curves are not supported.");
+        return nullptr;
+    }
+    if (p < 1 || p > BSplineAlgorithms::MAX_DEGREE) {
+        Log::errorToConsole("Error in CreateApproximated: degree must be between 1 and ", BSplineAlgorithms::MAX_DEGREE, ".");
+        return nullptr;
+    }
+    if (ctrlPointCount < p + 1 || dataPoints.size() < ctrlPointCount) {
+        Log::errorToConsole("Error in CreateApproximated: need at least ", p + 1, " control points and at least as many data points.");
+        return nullptr;
+    }
+
+    // the weighted data is fitted in homogeneous space, like in CreateInterpolatedWithParams
+    std::vector<glm::vec4> Q, cartesianPoints;
+    if (!BSplineInterpolation::HomogenizeDataPoints(dataPoints, Q, cartesianPoints)) {
+        return nullptr;
+    }
+
+    std::vector<float> t_values = BSplineInterpolation::CalculateParametricTs(dataPoints, 0.5f);
+    BSplineFitter fitter(ctrlPointCount, p);
+    std::vector<glm::vec4> P_ctrlPoints;
+    for (int step = 0; step <= correctionSteps; ++step) {
+        if (step > 0) {
+            fitter.BeginCorrection(P_ctrlPoints);
+        }
+        fitter.AddPoints(Q.data(), t_values.data(), Q.size());
+        if (!fitter.Solve(P_ctrlPoints)) {
+            return nullptr;
+        }
+    }
+    BSplineInterpolation::FixPolynomialWeights(dataPoints, P_ctrlPoints);
+
+    BSpline* newSpline = new BSpline(params);
+    newSpline->SetCtrlPoints(P_ctrlPoints);
+    newSpline->SetKnots(fitter.GetKnots());
+
+    return newSpline;
+}
+
+// Implementation of the static method in the BSpline class
+// The NURBS Book, A7.1: rational quadratic pieces of at most 90 degrees joined with double knots.
+inline BSpline* BSpline::CreateArc(
+    glm::vec3 center,
+    glm::vec3 xAxis,
+    glm::vec3 yAxis,
+    float radius,
+    float startAngle,
+    float endAngle,
+    BSplineParams params
+) {
+    float theta = endAngle - startAngle;
+    if (radius <= 0.f || theta <= 0.f || theta > 2.f * glm::pi<float>() + BSplineInterpolation::EPSILON) {
+        Log::errorToConsole("Error in CreateArc: the radius must be positive and the angle range in (0, 2 pi].");
+        return nullptr;
+    }
+    // the axes only span the plane, the arc is drawn in an orthonormal frame of it
+    glm::vec3 X = glm::length(xAxis) > BSplineInterpolation::EPSILON ? glm::normalize(xAxis) : glm::vec3(0);
+    glm::vec3 Y = yAxis - glm::dot(yAxis, X) * X;
+    if (glm::length(X) == 0.f || glm::length(Y) < BSplineInterpolation::EPSILON) {
+        Log::errorToConsole("Error in CreateArc: the axes must span a plane.");
+        return nullptr;
+    }
+    Y = glm::normalize(Y);
+
+    int pieces = glm::clamp(int(std::ceil(theta / (0.5f * glm::pi<float>()) - BSplineInterpolation::EPSILON)), 1, 4);
+    float delta = theta / float(pieces);
+    float w1 = std::cos(0.5f * delta);
+    auto point = [&](float angle) {
+        return center + radius * (std::cos(angle) * X + std::sin(angle) * Y);
+    };
+    auto tangent = [&](float angle) {
+        return -std::sin(angle) * X + std::cos(angle) * Y;
+    };
+
+    // the middle control point is where the end tangents of the piece meet
+    std::vector<glm::vec4> P_ctrlPoints{ glm::vec4(point(startAngle), 1) };
+    std::vector<float> U{ 0.f, 0.f, 0.f };
+    for (int i = 0; i < pieces; ++i) {
+        float angle = startAngle + delta * float(i);
+        glm::vec3 middle = point(angle) + radius * std::tan(0.5f * delta) * tangent(angle);
+        P_ctrlPoints.push_back(BezierAlgorithms::Homogenize(middle, w1));
+        P_ctrlPoints.push_back(glm::vec4(point(i + 1 == pieces ? endAngle : angle + delta), 1));
+        if (i + 1 < pieces) {
+            U.push_back(float(i + 1) / float(pieces));
+            U.push_back(float(i + 1) / float(pieces));
+        }
+    }
+    U.insert(U.end(), { 1.f, 1.f, 1.f });
+
+    params.degree = 2;
+    params.periodic = false;
+    BSpline* newSpline = new BSpline(params);
+    newSpline->SetCtrlPoints(P_ctrlPoints);
+    newSpline->SetKnots(U);
+
+    return newSpline;
 }
\ No newline at end of file
@@ -0,0 +1,323 @@
+#pragma once
+
+#include "../include_all.h"
+
+// Linear systems with banded matrices, the right-hand side has four channels (glm::vec4)
+// which are solved together in one pass over the factorization.
+namespace BandedSystem {
+
+	constexpr float EPSILON = 1e-12f;
+
+	/**
+	 * @brief n x n matrix with nonzeros only on the diagonals -lower ... upper.
+	 * Stored row by row, lower + upper + 1 values per row, entry (i, j) at i * width + j - i + lower.
+	 */
+	struct BandedMatrix {
+		int n = 0;
+		int lower = 0;
+		int upper = 0;
+		std::vector<float> values{};
+
+		BandedMatrix() = default;
+		BandedMatrix(int n, int lower, int upper) : n(n), lower(lower), upper(upper), values(n * (lower + upper + 1), 0.f) {}
+
+		inline int Width() const {
+			return lower + upper + 1;
+		}
+		inline bool InBand(int i, int j) const {
+			return j - i >= -lower && j - i <= upper;
+		}
+		/**
+		 * @brief Entry (i, j), only valid inside the band.
+		 */
+		inline float& operator()(int i, int j) {
+			return values[i * Width() + j - i + lower];
+		}
+		inline float operator()(int i, int j) const {
+			return InBand(i, j) ? values[i * Width() + j - i + lower] : 0.f;
+		}
+	};
+
+	/**
+	 * @brief In-place LU factorization without pivoting in O(n * lower * upper): the multipliers of L
+	 * (unit diagonal) are stored below the diagonal, U on and above it. Without row exchanges the band
+	 * does not grow. This is stable for totally positive matrices such as B-Spline collocation matrices.
+	 * @return false if a pivot is zero.
+	 */
+	inline bool FactorLU(BandedMatrix& A) {
+		for (int k = 0; k < A.n; ++k) {
+			float pivot = A(k, k);
+			if (std::abs(pivot) < EPSILON) {
+				return false;
+			}
+			int lastRow = glm::min(k + A.lower, A.n - 1);
+			int lastCol = glm::min(k + A.upper, A.n - 1);
+			for (int i = k + 1; i <= lastRow; ++i) {
+				float m = A(i, k) / pivot;
+				A(i, k) = m;
+				for (int j = k + 1; j <= lastCol; ++j) {
+					A(i, j) -= m * A(k, j);
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Solves L y = b in place with the factors of FactorLU.
+	 */
+	inline void ForwardLU(const BandedMatrix& LU, glm::vec4* b) {
+		for (int i = 0; i < LU.n; ++i) {
+			for (int j = glm::max(0, i - LU.lower); j < i; ++j) {
+				b[i] -= LU(i, j) * b[j];
+			}
+		}
+	}
+
+	/**
+	 * @brief Solves U x = y in place with the factors of FactorLU.
+	 */
+	inline void BackwardLU(const BandedMatrix& LU, glm::vec4* b) {
+		for (int i = LU.n - 1; i >= 0; --i) {
+			int lastCol = glm::min(i + LU.upper, LU.n - 1);
+			for (int j = i + 1; j <= lastCol; ++j) {
+				b[i] -= LU(i, j) * b[j];
+			}
+			b[i] /= LU(i, i);
+		}
+	}
+
+	/**
+	 * @brief Solves A x = b in place with the factors of FactorLU.
+	 */
+	inline void SolveLU(const BandedMatrix& LU, std::vector<glm::vec4>& b) {
+		ForwardLU(LU, b.data());
+		BackwardLU(LU, b.data());
+	}
+
+	/**
+	 * @brief Symmetric positive definite n x n matrix with nonzeros only on the diagonals -bandwidth ... bandwidth.
+	 * Only the lower band is stored, entry (i, j) with i - bandwidth <= j <= i at i * (bandwidth + 1) + j - i + bandwidth.
+	 * The values are doubles, the normal equations of a least-squares fit sum up millions of products.
+	 */
+	struct SymmetricBandedMatrix {
+		int n = 0;
+		int bandwidth = 0;
+		std::vector<double> values{};
+
+		SymmetricBandedMatrix() = default;
+		SymmetricBandedMatrix(int n, int bandwidth) : n(n), bandwidth(bandwidth), values(n * (bandwidth + 1), 0.0) {}
+
+		/**
+		 * @brief Entry (i, j) of the lower band, j <= i.
+		 */
+		inline double& operator()(int i, int j) {
+			return values[i * (bandwidth + 1) + j - i + bandwidth];
+		}
+		inline double operator()(int i, int j) const {
+			return values[i * (bandwidth + 1) + j - i + bandwidth];
+		}
+	};
+
+	/**
+	 * @brief In-place Cholesky factorization A = L L^T in O(n * bandwidth^2), L overwrites the lower band.
+	 * @return false if the matrix is not positive definite.
+	 */
+	inline bool FactorCholesky(SymmetricBandedMatrix& A) {
+		for (int j = 0; j < A.n; ++j) {
+			int first = glm::max(0, j - A.bandwidth);
+			double diagonal = A(j, j);
+			for (int k = first; k < j; ++k) {
+				diagonal -= A(j, k) * A(j, k);
+			}
+			if (diagonal <= EPSILON) {
+				return false;
+			}
+			diagonal = std::sqrt(diagonal);
+			A(j, j) = diagonal;
+
+			int lastRow = glm::min(j + A.bandwidth, A.n - 1);
+			for (int i = j + 1; i <= lastRow; ++i) {
+				double sum = A(i, j);
+				for (int k = glm::max(0, i - A.bandwidth); k < j; ++k) {
+					sum -= A(i, k) * A(j, k);
+				}
+				A(i, j) = sum / diagonal;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Solves A x = b in place with the factor of FactorCholesky: L y = b, then L^T x = y.
+	 */
+	inline void SolveCholesky(const SymmetricBandedMatrix& L, std::vector<glm::dvec4>& b) {
+		for (int i = 0; i < L.n; ++i) {
+			for (int k = glm::max(0, i - L.bandwidth); k < i; ++k) {
+				b[i] -= L(i, k) * b[k];
+			}
+			b[i] /= L(i, i);
+		}
+		for (int i = L.n - 1; i >= 0; --i) {
+			int lastRow = glm::min(i + L.bandwidth, L.n - 1);
+			for (int k = i + 1; k <= lastRow; ++k) {
+				b[i] -= L(k, i) * b[k];
+			}
+			b[i] /= L(i, i);
+		}
+	}
+
+	/**
+	 * @brief n x n cyclic banded matrix: entry (i, j) is nonzero only if (j - i) mod n is in [-lower, upper],
+	 * like the collocation matrix of a periodic B-Spline.
+	 * With m = lower + upper, the leading (n - m) x (n - m) block is banded and the wrapped entries
+	 * fall into the last m columns and the last m rows, which are stored densely.
+	 */
+	struct PeriodicBandedMatrix {
+		int n = 0;
+		int lower = 0;
+		int upper = 0;
+		int border = 0;					// m, size of the dense borders
+		BandedMatrix core{};			// leading (n - m) x (n - m) block
+		std::vector<float> right{};		// (n - m) x m, last columns of the leading rows
+		std::vector<float> bottom{};	// m x (n - m), leading columns of the last rows
+		std::vector<float> corner{};	// m x m
+		std::vector<int> pivots{};		// row exchanges of the corner factorization
+
+		PeriodicBandedMatrix() = default;
+		PeriodicBandedMatrix(int n, int lower, int upper) : n(n), lower(lower), upper(upper) {
+			border = glm::min(lower + upper, n);
+			int r = n - border;
+			core = BandedMatrix(r, lower, upper);
+			right.assign(r * border, 0.f);
+			bottom.assign(border * r, 0.f);
+			corner.assign(border * border, 0.f);
+		}
+
+		/**
+		 * @brief Entry (i, j) for 0 <= i, j < n, the caller wraps the column index.
+		 */
+		inline float& At(int i, int j) {
+			int r = n - border;
+			if (i < r) {
+				return j < r ? core(i, j) : right[i * border + j - r];
+			}
+			return j < r ? bottom[(i - r) * r + j] : corner[(i - r) * border + j - r];
+		}
+	};
+
+	/**
+	 * @brief Block LU factorization of a cyclic banded matrix in O(n * m^2):
+	 * the banded core is factored without pivoting, the borders are eliminated against it and the
+	 * remaining m x m Schur complement is factored with partial pivoting.
+	 * @return false if a pivot is zero.
+	 */
+	inline bool FactorLU(PeriodicBandedMatrix& A) {
+		int r = A.n - A.border;
+		int m = A.border;
+		if (!FactorLU(A.core)) {
+			return false;
+		}
+
+		// right border: L^-1 C, column by column
+		for (int c = 0; c < m; ++c) {
+			for (int i = 0; i < r; ++i) {
+				float sum = A.right[i * m + c];
+				for (int j = glm::max(0, i - A.core.lower); j < i; ++j) {
+					sum -= A.core(i, j) * A.right[j * m + c];
+				}
+				A.right[i * m + c] = sum;
+			}
+		}
+		// bottom border: D U^-1, row by row
+		for (int row = 0; row < m; ++row) {
+			float* d = A.bottom.data() + row * r;
+			for (int j = 0; j < r; ++j) {
+				float sum = d[j];
+				for (int k = glm::max(0, j - A.core.upper); k < j; ++k) {
+					sum -= d[k] * A.core(k, j);
+				}
+				d[j] = sum / A.core(j, j);
+			}
+		}
+		// Schur complement E - (D U^-1)(L^-1 C)
+		for (int row = 0; row < m; ++row) {
+			for (int c = 0; c < m; ++c) {
+				float sum = 0.f;
+				for (int k = 0; k < r; ++k) {
+					sum += A.bottom[row * r + k] * A.right[k * m + c];
+				}
+				A.corner[row * m + c] -= sum;
+			}
+		}
+
+		// dense LU of the corner with partial pivoting
+		A.pivots.resize(m);
+		for (int k = 0; k < m; ++k) {
+			int best = k;
+			for (int i = k + 1; i < m; ++i) {
+				if (std::abs(A.corner[i * m + k]) > std::abs(A.corner[best * m + k])) {
+					best = i;
+				}
+			}
+			A.pivots[k] = best;
+			if (best != k) {
+				for (int j = 0; j < m; ++j) {
+					std::swap(A.corner[k * m + j], A.corner[best * m + j]);
+				}
+			}
+			float pivot = A.corner[k * m + k];
+			if (std::abs(pivot) < EPSILON) {
+				return false;
+			}
+			for (int i = k + 1; i < m; ++i) {
+				float factor = A.corner[i * m + k] / pivot;
+				A.corner[i * m + k] = factor;
+				for (int j = k + 1; j < m; ++j) {
+					A.corner[i * m + j] -= factor * A.corner[k * m + j];
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Solves A x = b in place with the factors of FactorLU.
+	 */
+	inline void SolveLU(const PeriodicBandedMatrix& A, std::vector<glm::vec4>& b) {
+		int r = A.n - A.border;
+		int m = A.border;
+		glm::vec4* x = b.data();
+		glm::vec4* y = b.data() + r;
+
+		// z = L^-1 b, w = c - (D U^-1) z
+		ForwardLU(A.core, x);
+		for (int row = 0; row < m; ++row) {
+			for (int k = 0; k < r; ++k) {
+				y[row] -= A.bottom[row * r + k] * x[k];
+			}
+		}
+		// solve the Schur complement
+		for (int k = 0; k < m; ++k) {
+			std::swap(y[k], y[A.pivots[k]]);
+		}
+		for (int i = 0; i < m; ++i) {
+			for (int j = 0; j < i; ++j) {
+				y[i] -= A.corner[i * m + j] * y[j];
+			}
+		}
+		for (int i = m - 1; i >= 0; --i) {
+			for (int j = i + 1; j < m; ++j) {
+				y[i] -= A.corner[i * m + j] * y[j];
+			}
+			y[i] /= A.corner[i * m + i];
+		}
+		// x = U^-1 (z - (L^-1 C) y)
+		for (int i = 0; i < r; ++i) {
+			for (int c = 0; c < m; ++c) {
+				x[i] -= A.right[i * m + c] * y[c];
+			}
+		}
+		BackwardLU(A.core, x);
+	}
+}
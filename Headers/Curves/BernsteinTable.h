@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Bernstein basis B_{n,k}(t_i) and its derivative sampled at t_i = i / (division - 1).
+ * Values are stored row by row, the weights of sample i start at i * (n + 1).
+ */
+struct BernsteinTable {
+	int degree = 0;
+	int division = 0;
+	std::vector<double> weights{};
+	std::vector<double> derivatives{};
+	GLuint ssboID = 0;		// float copy of the weights followed by the derivatives
+
+	inline double Weight(int i, int k) const {
+		return weights[i * (degree + 1) + k];
+	}
+	inline double Derivative(int i, int k) const {
+		return derivatives[i * (degree + 1) + k];
+	}
+};
+
+/**
+ * @brief Process-wide cache of Bernstein tables keyed by (degree, division).
+ * A table is built once, the first time it is requested, and is shared by every curve
+ * and surface using the same pair. References stay valid until Clean() is called.
+ */
+class BernsteinTableCache {
+protected:
+	static inline std::map<std::pair<int, int>, std::unique_ptr<BernsteinTable>> m_tables{};
+	static inline std::mutex m_mutex{};
+
+	static BernsteinTable& GetLocked(int degree, int division);
+	static void Build(BernsteinTable& table);
+
+public:
+	/**
+	 * @brief Returns the table of the pair, builds it if needed. Safe to call from any thread.
+	 */
+	static const BernsteinTable& Get(int degree, int division);
+	/**
+	 * @brief Returns the SSBO holding the table, uploads it on the first call.
+	 * Has to be called from the thread owning the OpenGL context.
+	 * Layout: float weights[division * (degree + 1)], float derivatives[division * (degree + 1)]
+	 */
+	static GLuint GetSSBO(int degree, int division);
+	/**
+	 * @brief Deletes every table and its SSBO.
+	 */
+	static void Clean();
+};
\ No newline at end of file
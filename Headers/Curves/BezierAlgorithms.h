@@ -0,0 +1,228 @@
+#pragma once
+
+#include "../include_all.h"
+
+// Control point based Bezier curve algorithms, independent from the GL state.
+namespace BezierAlgorithms {
+
+	// number of samples used to measure the distance of two curves
+	constexpr int DEVIATION_SAMPLES = 256;
+	constexpr float EPSILON = 1e-6f;
+
+	inline double Binomial(int n, int k) {
+		if (k < 0 || k > n) {
+			return 0.0;
+		}
+		double result = 1.0;
+		for (int i = 1; i <= k; ++i) {
+			result *= double(n - (k - i)) / double(i);
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Raises the degree of the curve by r in one step, the shape does not change.
+	 * Q_i = sum_j C(n, j) C(r, i - j) / C(n + r, i) * P_j
+	 */
+	inline std::vector<glm::vec4> ElevateDegree(const std::vector<glm::vec4>& P, int r) {
+		int n = P.size() - 1;
+		std::vector<glm::vec4> Q(n + r + 1);
+		for (int i = 0; i <= n + r; ++i) {
+			glm::dvec4 q(0);
+			double denom = Binomial(n + r, i);
+			for (int j = glm::max(0, i - r); j <= glm::min(n, i); ++j) {
+				q += Binomial(n, j) * Binomial(r, i - j) / denom * glm::dvec4(P[j]);
+			}
+			Q[i] = glm::vec4(q);
+		}
+		return Q;
+	}
+
+	/**
+	 * @brief Degree m curve closest to the curve in the continuous L2 sense (integral of the squared distance over [0, 1]).
+	 * With preserveEndpoints the first and last control points are kept, only the inner ones are fitted.
+	 * Uses the exact Bernstein product integrals: int B_{a,i} B_{b,j} = C(a,i) C(b,j) / (C(a+b, i+j) (a+b+1)).
+	 */
+	inline std::vector<glm::vec4> ReduceDegree(const std::vector<glm::vec4>& P, int m, bool preserveEndpoints) {
+		int n = P.size() - 1;
+		auto product = [](int a, int i, int b, int j) {
+			return Binomial(a, i) * Binomial(b, j) / (Binomial(a + b, i + j) * double(a + b + 1));
+		};
+
+		// unknown control points
+		int first = preserveEndpoints ? 1 : 0;
+		int last = preserveEndpoints ? m - 1 : m;
+		std::vector<glm::vec4> Q(m + 1);
+		if (preserveEndpoints) {
+			Q[0] = P[0];
+			Q[m] = P[n];
+		}
+		int size = last - first + 1;
+		if (size <= 0) {
+			return Q;
+		}
+
+		// normal equations: G Q = H P - (terms of the fixed end points)
+		Eigen::MatrixXd G(size, size);
+		Eigen::MatrixXd rhs = Eigen::MatrixXd::Zero(size, 4);
+		for (int i = first; i <= last; ++i) {
+			for (int j = first; j <= last; ++j) {
+				G(i - first, j - first) = product(m, i, m, j);
+			}
+			for (int k = 0; k <= n; ++k) {
+				double h = product(m, i, n, k);
+				for (int c = 0; c < 4; ++c) {
+					rhs(i - first, c) += h * P[k][c];
+				}
+			}
+			if (preserveEndpoints) {
+				double g0 = product(m, i, m, 0);
+				double gm = product(m, i, m, m);
+				for (int c = 0; c < 4; ++c) {
+					rhs(i - first, c) -= g0 * Q[0][c] + gm * Q[m][c];
+				}
+			}
+		}
+		Eigen::MatrixXd X = G.ldlt().solve(rhs);
+		for (int i = first; i <= last; ++i) {
+			Q[i] = glm::vec4(X(i - first, 0), X(i - first, 1), X(i - first, 2), X(i - first, 3));
+		}
+		return Q;
+	}
+
+	/**
+	 * @brief Splits the curve at every parameter of params in one pass (de Casteljau on the remaining part).
+	 * params has to be sorted and inside [0, 1], parameters closer than EPSILON to the previous cut
+	 * or to the ends are skipped, so no degenerate segments are produced.
+	 * The control points of the segments are appended to segments one after the other, n + 1 points each,
+	 * neighbouring segments share their end points.
+	 * @return the number of segments written, 0 if params is invalid.
+	 */
+	inline int Split(const std::vector<glm::vec4>& P, const std::vector<float>& params, std::vector<glm::vec4>& segments) {
+		if (!std::is_sorted(params.begin(), params.end())
+			|| (!params.empty() && (params.front() < 0.f || params.back() > 1.f))) {
+			Log::errorToConsole("BezierAlgorithms::Split params have to be sorted and inside [0, 1]");
+			return 0;
+		}
+
+		int n = P.size() - 1;
+		segments.reserve(segments.size() + (params.size() + 1) * (n + 1));
+		std::vector<glm::vec4> col = P;	// remaining part of the curve, defined on [prev, 1]
+		float prev = 0.f;
+		int segmentCount = 0;
+		for (float t : params) {
+			if (t - prev < EPSILON || 1.f - t < EPSILON) {
+				continue;
+			}
+			float local = (t - prev) / (1.f - prev);
+			// left segment is the first column, the right one is the last point of every column
+			std::vector<glm::vec4> right(n + 1);
+			for (int i = 0; i <= n; ++i) {
+				segments.push_back(col[0]);
+				right[n - i] = col[n - i];
+				for (int j = 0; j < n - i; ++j) {
+					col[j] = (1 - local) * col[j] + local * col[j + 1];
+				}
+			}
+			col = std::move(right);
+			prev = t;
+			++segmentCount;
+		}
+		segments.insert(segments.end(), col.begin(), col.end());
+		return segmentCount + 1;
+	}
+
+	/**
+	 * @brief Scaled Bernstein coefficients C(n, k) P_k, the curve is sum_k C(n, k) P_k t^k (1 - t)^(n - k),
+	 * which the shaders evaluate with Horner's scheme in O(n).
+	 */
+	inline std::vector<glm::vec4> ScaledBernstein(const std::vector<glm::vec4>& P) {
+		int n = P.size() - 1;
+		std::vector<glm::vec4> Q(P.size());
+		for (int k = 0; k <= n; ++k) {
+			Q[k] = float(Binomial(n, k)) * P[k];
+		}
+		return Q;
+	}
+
+	/**
+	 * @brief Scaled Bernstein coefficients of a tensor-product surface (row-major, rows along v, columns along u)
+	 * and of its two partial derivatives, one after the other:
+	 * - C(n_v, i) C(n_u, j) P_ij at [i * cols + j]
+	 * - C(n_v, i) C(n_u - 1, j) n_u (P_i,j+1 - P_ij) at [rows * cols + i * (cols - 1) + j]
+	 * - C(n_v - 1, i) C(n_u, j) n_v (P_i+1,j - P_ij) at [rows * cols + rows * (cols - 1) + i * cols + j]
+	 */
+	inline std::vector<glm::vec4> ScaledBernsteinSurface(const std::vector<glm::vec4>& P, int rows, int cols) {
+		int nu = cols - 1;
+		int nv = rows - 1;
+		std::vector<glm::vec4> Q;
+		Q.reserve(rows * cols + rows * nu + nv * cols);
+		for (int i = 0; i < rows; ++i) {
+			for (int j = 0; j < cols; ++j) {
+				Q.push_back(float(Binomial(nv, i) * Binomial(nu, j)) * P[i * cols + j]);
+			}
+		}
+		for (int i = 0; i < rows; ++i) {
+			for (int j = 0; j < nu; ++j) {
+				Q.push_back(float(Binomial(nv, i) * Binomial(nu - 1, j) * nu) * (P[i * cols + j + 1] - P[i * cols + j]));
+			}
+		}
+		for (int i = 0; i < nv; ++i) {
+			for (int j = 0; j < cols; ++j) {
+				Q.push_back(float(Binomial(nv - 1, i) * Binomial(nu, j) * nv) * (P[(i + 1) * cols + j] - P[i * cols + j]));
+			}
+		}
+		return Q;
+	}
+
+	/**
+	 * @brief Control points of rational curves are stored in homogeneous form (w x, w y, w z, w),
+	 * so the polynomial algorithms (de Casteljau, knot insertion, transforms) work on them unchanged
+	 * and the curve point is the projection of the result. Polynomial curves have w = 1 everywhere.
+	 */
+	inline glm::vec4 Homogenize(const glm::vec3& point, float weight) {
+		return glm::vec4(point * weight, weight);
+	}
+	inline glm::vec4 Dehomogenize(const glm::vec4& point) {
+		if (std::abs(point.w) < EPSILON) {
+			return glm::vec4(glm::vec3(point), 1.f);
+		}
+		return glm::vec4(glm::vec3(point) / point.w, 1.f);
+	}
+	inline bool IsRational(const std::vector<glm::vec4>& P) {
+		for (const auto& point : P) {
+			if (std::abs(point.w - 1.f) > EPSILON) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief First and second derivative of a rational curve C = A / w from the derivatives of its homogeneous form:
+	 * C' = (A' - w' C) / w, C'' = (A'' - 2 w' C' - w'' C) / w.
+	 * @param d2 may be zero, then c2 is not computed.
+	 */
+	inline void RationalDerivatives(const glm::vec4& a, const glm::vec4& d1, const glm::vec4* d2, glm::vec3& c, glm::vec3& c1, glm::vec3* c2) {
+		float w = std::abs(a.w) < EPSILON ? 1.f : a.w;
+		c = glm::vec3(a) / w;
+		c1 = (glm::vec3(d1) - d1.w * c) / w;
+		if (d2 != nullptr && c2 != nullptr) {
+			*c2 = (glm::vec3(*d2) - 2.f * d1.w * c1 - d2->w * c) / w;
+		}
+	}
+
+	/**
+	 * @brief Largest distance between the points of the two curves at the same parameter.
+	 */
+	inline float MaxDeviation(const std::vector<glm::vec4>& P, const std::vector<glm::vec4>& Q) {
+		std::vector<glm::vec4> a, b;
+		BezierEvaluator(P).EvaluateUniform(DEVIATION_SAMPLES, a);
+		BezierEvaluator(Q).EvaluateUniform(DEVIATION_SAMPLES, b);
+		float deviation = 0.f;
+		for (int i = 0; i < DEVIATION_SAMPLES; ++i) {
+			deviation = glm::max(deviation, glm::length(glm::vec3(a[i]) - glm::vec3(b[i])));
+		}
+		return deviation;
+	}
+}
\ No newline at end of file
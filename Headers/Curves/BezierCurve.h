@@ -5,19 +5,36 @@
 class BezierCurve : public ModelBase {
 protected:
 	std::vector<glm::vec4> m_ctrlPoints{};
+	int m_segmentCount = 1;		// m_ctrlPoints holds m_segmentCount curves of the same degree one after the other
 	GLuint m_ctrlPointsSSBOID = 0;
 	bool m_ctrlPointsDirty = false;
+	GLuint m_coefficientsSSBOID = 0;		// scaled Bernstein coefficients of every segment for Horner evaluation
 	int m_smoothness = 10;
 	glm::vec3 m_color = {1.f, 0, 1.f};
-	
-	void SetCtrlPointsSSBO() {
-		glGenBuffers(1, &m_ctrlPointsSSBOID);
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ctrlPointsSSBOID);
-		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_ctrlPointsSSBOID);
-		WriteCtrlPointsSSBO();
-	}
 
-	void WriteCtrlPointsSSBO() {
+	TessellationMode m_tessellationMode = TessellationMode::Cached;
+	float m_tolerance = 0.01f;
+	bool m_screenSpaceTolerance = false;
+	GLuint m_tessellationVAOID = 0;
+	GLuint m_tessellationVBOID = 0;
+	int m_tessellationVertexCount = 0;
+	bool m_tessellationDirty = true;
+	glm::mat4 m_tessellationViewProj{};		// camera of the last screen space tessellation
+	glm::ivec2 m_tessellationViewport{};
+
+	ArcLengthTable m_arcLengthTable{};		// parameter u in [0, m_segmentCount], segment s is [s, s + 1]
+	bool m_arcLengthDirty = true;
+	bool m_arcLengthSampling = false;		// place the samples evenly by arc length
+	ArcLengthTable m_renderArcLengthTable{};	// the same for the transformed curve, spaces the rendered samples
+	bool m_renderArcLengthDirty = true;
+
+	/**
+	 * @brief Arc-length table of the transformed curve, rebuilt if the control points or the transformation changed.
+	 * The rendered samples are spaced with it, so they stay even under a non-uniform scale or shear.
+	 */
+	ArcLengthTable& GetRenderArcLengthTable();
+
+	std::vector<glm::vec4> GetTransformedCtrlPoints() {
 		// apply world transformation on 
 		std::vector<glm::vec4> newPoints;
 		for (int i = 0; i < m_ctrlPoints.size(); ++i) {
@@ -27,12 +44,98 @@ protected:
 				newPoints.push_back(m_ctrlPoints[i]);
 			}
 		}
+		return newPoints;
+	}
+	
+	void SetCtrlPointsSSBO() {
+		glGenBuffers(1, &m_ctrlPointsSSBOID);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ctrlPointsSSBOID);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_ctrlPointsSSBOID);
+		WriteCtrlPointsSSBO();
+	}
+
+	void WriteCtrlPointsSSBO() {
+		std::vector<glm::vec4> newPoints = GetTransformedCtrlPoints();
 		// write to buffer
 		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ctrlPointsSSBOID);
 		glBufferData(GL_SHADER_STORAGE_BUFFER,
 			newPoints.size() * sizeof(glm::vec4),
 			newPoints.data(),
 			GL_STATIC_DRAW);
+		WriteCoefficientsSSBO(newPoints);
+	}
+	void WriteCoefficientsSSBO(const std::vector<glm::vec4>& points) {
+		if (m_coefficientsSSBOID == 0) {
+			glCreateBuffers(1, &m_coefficientsSSBOID);
+		}
+		int count = GetDegree() + 1;
+		std::vector<glm::vec4> coefficients;
+		coefficients.reserve(points.size());
+		for (int s = 0; s < m_segmentCount; ++s) {
+			std::vector<glm::vec4> segment(points.begin() + s * count, points.begin() + (s + 1) * count);
+			std::vector<glm::vec4> scaled = BezierAlgorithms::ScaledBernstein(segment);
+			coefficients.insert(coefficients.end(), scaled.begin(), scaled.end());
+		}
+		glNamedBufferData(m_coefficientsSSBOID,
+			coefficients.size() * sizeof(glm::vec4),
+			coefficients.data(),
+			GL_STATIC_DRAW);
+	}
+
+	void SetTessellationVBO() {
+		glCreateBuffers(1, &m_tessellationVBOID);
+		glCreateVertexArrays(1, &m_tessellationVAOID);
+		glVertexArrayVertexBuffer(m_tessellationVAOID, 0, m_tessellationVBOID, 0, sizeof(glm::vec4));
+		glEnableVertexArrayAttrib(m_tessellationVAOID, 0);
+		glVertexArrayAttribBinding(m_tessellationVAOID, 0, 0);
+		glVertexArrayAttribFormat(m_tessellationVAOID, 0, 4, GL_FLOAT, GL_FALSE, 0);
+	}
+
+	void WriteTessellationVBO(RenderParams* p) {
+		std::vector<glm::vec4> points;
+		std::vector<glm::vec4> ctrlPoints = GetTransformedCtrlPoints();
+		int count = GetDegree() + 1;
+		CurveTessellation::AdaptiveParams adaptive;
+		adaptive.tolerance = m_tolerance;
+		adaptive.screenSpace = m_screenSpaceTolerance;
+		adaptive.viewProj = p->viewProj;
+		adaptive.viewport = p->windowSize;
+		if (GetTessellationMode() == TessellationMode::Cached && GetArcLengthSampling()) {
+			std::vector<BezierEvaluator> segments;
+			for (int s = 0; s < m_segmentCount; ++s) {
+				segments.emplace_back(ctrlPoints.data() + s * count, count);
+			}
+			std::vector<float> params;
+			GetRenderArcLengthTable().GetUniformParams(GetSmoothness() * m_segmentCount, params);
+			for (float u : params) {
+				int s = glm::clamp((int)u, 0, m_segmentCount - 1);
+				points.push_back(segments[s].Evaluate(u - s));
+			}
+		}
+		else {
+			for (int s = 0; s < m_segmentCount; ++s) {
+				std::vector<glm::vec4> segment(ctrlPoints.begin() + s * count, ctrlPoints.begin() + (s + 1) * count);
+				if (GetTessellationMode() == TessellationMode::Adaptive) {
+					CurveTessellation::AdaptiveBezier(segment, adaptive, points);
+				}
+				else {
+					std::vector<glm::vec4> segmentPoints;
+					CurveTessellation::TessellateBezier(segment, GetSmoothness(), segmentPoints);
+					// neighbouring segments share their end points
+					points.insert(points.end(), segmentPoints.begin() + (s > 0 ? 1 : 0), segmentPoints.end());
+				}
+			}
+		}
+		if (GetTessellationMode() == TessellationMode::Adaptive) {
+			m_tessellationViewProj = p->viewProj;
+			m_tessellationViewport = p->windowSize;
+		}
+		glNamedBufferData(m_tessellationVBOID,
+			points.size() * sizeof(glm::vec4),
+			points.data(),
+			GL_STATIC_DRAW);
+		m_tessellationVertexCount = points.size();
+		m_tessellationDirty = false;
 	}
 
 	static float binomialCoeff(int n, int k) {
@@ -66,6 +169,9 @@ public:
 	*/
 
 	inline void SetSmoothness(int smoothness) {
+		if (smoothness != m_smoothness) {
+			m_tessellationDirty = true;
+		}
 		m_smoothness = smoothness;
 	}
 	inline int GetSmoothness() const {
@@ -78,28 +184,82 @@ public:
 	}
 
 	inline void AddCtrlPoint(glm::vec3 newPoint) {
+		if (m_segmentCount > 1) {
+			Log::errorToConsole("Bezier::AddCtrlPoint not supported on curves with multiple segments");
+			return;
+		}
 		m_ctrlPoints.push_back(glm::vec4(newPoint, 1));
 		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_renderArcLengthDirty = true;
 	}
 	inline void DelCtrlPoint(int index) {
 		if (index < 0 || index > m_ctrlPoints.size() - 1) {
 			Log::errorToConsole("Bezier::DelCtrlPoint invalid index");
 			return;
 		}
+		if (m_segmentCount > 1) {
+			Log::errorToConsole("Bezier::DelCtrlPoint not supported on curves with multiple segments");
+			return;
+		}
 		m_ctrlPoints.erase(m_ctrlPoints.begin() + index);
 		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_renderArcLengthDirty = true;
 	}
 	inline void SetCtrlPoint(int index, glm::vec3 position) {
 		if (index < 0 || index > m_ctrlPoints.size() - 1) {
 			Log::errorToConsole("Bezier::SetCtrlPoint invalid index");
 			return;
 		}
+		// a joint of two segments is stored in both of them, a shared copy moves with the edited one
+		int count = GetDegree() + 1;
+		int local = index % count;
+		if (local == count - 1 && index + 1 < m_ctrlPoints.size() && m_ctrlPoints[index + 1] == m_ctrlPoints[index]) {
+			m_ctrlPoints[index + 1] = glm::vec4(position, 1);
+		}
+		else if (local == 0 && index > 0 && m_ctrlPoints[index - 1] == m_ctrlPoints[index]) {
+			m_ctrlPoints[index - 1] = glm::vec4(position, 1);
+		}
 		m_ctrlPoints[index] = glm::vec4(position, 1);
 		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_renderArcLengthDirty = true;
 	}
 	inline void SetCtrlPoints(std::vector<glm::vec4> points) {
 		m_ctrlPoints = points;
+		m_segmentCount = 1;
 		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_renderArcLengthDirty = true;
+	}
+	/**
+	 * @brief Sets segmentCount curves of the same degree stored one after the other, rendered as one curve.
+	 */
+	inline void SetSegments(std::vector<glm::vec4> points, int segmentCount) {
+		if (segmentCount < 1 || points.size() % segmentCount != 0 || points.size() / segmentCount < 2) {
+			Log::errorToConsole("Bezier::SetSegments control point count does not match the segment count");
+			return;
+		}
+		m_ctrlPoints = points;
+		m_segmentCount = segmentCount;
+		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_renderArcLengthDirty = true;
+	}
+	inline int GetSegmentCount() const {
+		return m_segmentCount;
+	}
+	inline int GetDegree() const {
+		return m_ctrlPoints.size() / m_segmentCount - 1;
+	}
+	inline std::vector<glm::vec4> GetSegmentCtrlPoints(int segment) const {
+		if (segment < 0 || segment >= m_segmentCount) {
+			Log::errorToConsole("Bezier::GetSegmentCtrlPoints invalid segment index");
+			return {};
+		}
+		int count = GetDegree() + 1;
+		return std::vector<glm::vec4>(m_ctrlPoints.begin() + segment * count, m_ctrlPoints.begin() + (segment + 1) * count);
 	}
 	inline std::vector<glm::vec4> GetCtrlPoints() const {
 		return m_ctrlPoints;
@@ -107,6 +267,10 @@ public:
 	inline int GetCtrlPointCount() const {
 		return m_ctrlPoints.size();
 	}
+	// CPU evaluator of one untransformed segment, independent from the GL state
+	inline BezierEvaluator GetEvaluator(int segment = 0) const {
+		return BezierEvaluator(GetSegmentCtrlPoints(segment));
+	}
 	inline GLuint GetCtrlPointsSSBO() const {
 		return m_ctrlPointsSSBOID;
 	}
@@ -114,6 +278,24 @@ public:
 		m_applyTransforms = apply;
 		m_transformDirty = true;
 	}
+	inline void SetTessellationMode(TessellationMode mode) {
+		m_tessellationMode = mode;
+		m_tessellationDirty = true;
+	}
+	inline TessellationMode GetTessellationMode() const {
+		return m_tessellationMode;
+	}
+	inline void SetTolerance(float tolerance, bool screenSpace) {
+		m_tolerance = glm::max(tolerance, CurveTessellation::EPSILON);
+		m_screenSpaceTolerance = screenSpace;
+		m_tessellationDirty = true;
+	}
+	inline float GetTolerance() const {
+		return m_tolerance;
+	}
+	inline bool GetScreenSpaceTolerance() const {
+		return m_screenSpaceTolerance;
+	}
 	inline void SetColor(glm::vec3 color) {
 		m_color = color;
 	}
@@ -126,8 +308,59 @@ public:
 	inline glm::vec3 GetColor() const {
 		return m_color;
 	}
+	inline void SetArcLengthSampling(bool arcLength) {
+		m_arcLengthSampling = arcLength;
+		m_tessellationDirty = true;
+	}
+	inline bool GetArcLengthSampling() const {
+		return m_arcLengthSampling;
+	}
+
+	/**
+	 * @brief The segments of the curve as Bezier spans, segment s is defined on [s, s + 1].
+	 * @param world if set, the control points are transformed like the rendered curve.
+	 */
+	void GetBezierSpans(std::vector<std::vector<glm::vec4>>& spans, std::vector<float>& breaks, bool world = false) const;
+	/**
+	 * @brief Arc-length table of the untransformed curve, rebuilt if the control points changed.
+	 * Lengths are measured in the local space of the curve.
+	 * The parameter runs over [0, GetSegmentCount()].
+	 */
+	ArcLengthTable& GetArcLengthTable();
+	/**
+	 * @brief Point of the untransformed curve at arc length s from the start.
+	 */
+	glm::vec4 GetPointAtLength(float s);
+
+	/**
+	 * @brief Closest point queries on the untransformed curve, the parameter runs over [0, GetSegmentCount()].
+	 * Build it once and reuse it for every point of a batch.
+	 */
+	CurveProjector GetProjector() const;
+	/**
+	 * @brief Projects every point onto the untransformed curve, on multiple threads.
+	 */
+	std::vector<CurveProjection> Project(const std::vector<glm::vec3>& points, int threadCount = 0) const;
 
 	void Elevate();
 	void Reduce();
+	/**
+	 * @brief Changes the degree of the curve to target in one step. Elevation is exact, reduction is an
+	 * L2 least-squares fit, optionally keeping the end points.
+	 * @param maxDeviation if not nullptr, receives the largest distance between the old and the new curve.
+	 * @return false if the target degree is invalid.
+	 */
+	bool ChangeDegree(int target, float* maxDeviation = nullptr, bool preserveEndpoints = true);
 	void Cut(float t, BezierCurve*& newCurve2);
+	/**
+	 * @brief Splits the curve at every parameter of the sorted params in one pass.
+	 * The segments are written to segments one after the other, without creating any GL object.
+	 * @return the number of segments, 0 on error.
+	 */
+	int Split(const std::vector<float>& params, std::vector<glm::vec4>& segments) const;
+	/**
+	 * @brief Splits the curve at every parameter of the sorted params and keeps all segments
+	 * in this object, sharing one control point buffer.
+	 */
+	bool Cut(const std::vector<float>& params);
 };
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief CPU evaluator of a single Bezier control polygon, usable without an OpenGL context.
+ * Control points are stored in structure-of-arrays form, so de Casteljau's algorithm
+ * runs on 8 (AVX) or 4 (SSE) parameter values at once, with a scalar fallback for the rest.
+ * Batch functions take (pointer, count) ranges, the same way as std::span would.
+ */
+class BezierEvaluator {
+protected:
+	std::vector<float> m_x{};
+	std::vector<float> m_y{};
+	std::vector<float> m_z{};
+	std::vector<float> m_w{};
+
+	static constexpr int STACK_CTRL_POINTS = 16;	// up to this many control points the scratch lives on the stack
+
+	// one lane of the widest kernel, the scratch of a batch holds 4 * control point count lanes
+	struct alignas(32) ScratchLane {
+		float values[8];
+	};
+
+	// each kernel returns the number of parameter values it has processed,
+	// scratch is shared by the kernels of one batch
+	size_t EvaluateScalar(const float* t, size_t count, float* outX, float* outY, float* outZ, float* outW, ScratchLane* scratch) const;
+#ifdef SIMD_SSE
+	size_t EvaluateSSE(const float* t, size_t count, float* outX, float* outY, float* outZ, float* outW, ScratchLane* scratch) const;
+#endif
+#ifdef SIMD_AVX
+	size_t EvaluateAVX(const float* t, size_t count, float* outX, float* outY, float* outZ, float* outW, ScratchLane* scratch) const;
+#endif
+
+public:
+	BezierEvaluator() = default;
+	BezierEvaluator(const glm::vec4* ctrlPoints, size_t count);
+	BezierEvaluator(const std::vector<glm::vec4>& ctrlPoints);
+
+	void SetCtrlPoints(const glm::vec4* ctrlPoints, size_t count);
+	void SetCtrlPoints(const std::vector<glm::vec4>& ctrlPoints);
+
+	inline int GetCtrlPointCount() const {
+		return m_x.size();
+	}
+	inline int GetDegree() const {
+		return GetCtrlPointCount() - 1;
+	}
+
+	/**
+	 * @brief Evaluates the curve at a single parameter value.
+	 */
+	glm::vec4 Evaluate(float t) const;
+	/**
+	 * @brief Evaluates the curve at count parameter values into separate coordinate arrays.
+	 * Every output array has to hold at least count floats.
+	 */
+	void Evaluate(const float* t, size_t count, float* outX, float* outY, float* outZ, float* outW) const;
+	/**
+	 * @brief Evaluates the curve at count parameter values into out[0 .. count-1].
+	 */
+	void Evaluate(const float* t, size_t count, glm::vec4* out) const;
+	void Evaluate(const std::vector<float>& t, std::vector<glm::vec4>& out) const;
+	/**
+	 * @brief Evaluates the curve at division equidistant parameter values in [0, 1],
+	 * the same points the Bezier curve shader generates.
+	 */
+	void EvaluateUniform(int division, std::vector<glm::vec4>& out) const;
+};
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Intersection point of two curves added to a CurveIntersector.
+ */
+struct CurveIntersection {
+	int curveA = 0;
+	int curveB = 0;
+	float tA = 0;				// curve parameters of the intersection
+	float tB = 0;
+	glm::vec3 point{};
+};
+
+/**
+ * @brief Finds every intersection between a set of piecewise Bezier curves (spans and breaks as in ArcLengthTable).
+ * Broad phase: sweep and prune over the bounding boxes of the spans, so only spans of different curves
+ * with overlapping boxes are tested.
+ * Narrow phase: interval subdivision, a pair of pieces is rejected when the bounding boxes of their control
+ * points (which contain their convex hulls) are disjoint. Pieces smaller than the tolerance are hits, touching
+ * hits are merged and refined with Gauss-Newton iterations, so tangential intersections are found as well.
+ * Spans of rational curves have homogeneous control points, the boxes are taken around their projections.
+ */
+class CurveIntersector {
+protected:
+	static constexpr int MAX_DEPTH = 40;
+	static constexpr int MAX_HITS = 4096;		// per span pair, reached by overlapping curves
+	static constexpr int NEWTON_ITERATIONS = 10;
+
+	struct Span {
+		int curve = 0;
+		std::vector<glm::vec4> points;
+		float start = 0;
+		float end = 1;
+		glm::vec3 min{};
+		glm::vec3 max{};
+	};
+	struct Piece {
+		std::vector<glm::vec4> points;
+		float t0 = 0;		// local parameter range inside the span
+		float t1 = 1;
+		glm::vec3 min{};
+		glm::vec3 max{};
+	};
+	struct Hit {
+		float a0, a1;
+		float b0, b1;
+	};
+
+	std::vector<Span> m_spans{};
+	int m_curveCount = 0;
+
+	static Piece MakePiece(const std::vector<glm::vec4>& points, float t0, float t1);
+	static void Subdivide(const Piece& a, const Piece& b, float tolerance, int depth, std::vector<Hit>& hits);
+	void IntersectSpans(const Span& a, const Span& b, float tolerance, std::vector<CurveIntersection>& out) const;
+
+public:
+	/**
+	 * @brief Adds a curve given by its Bezier spans.
+	 * @return index of the curve, used in CurveIntersection.
+	 */
+	int AddCurve(const std::vector<std::vector<glm::vec4>>& spans, const std::vector<float>& breaks);
+	/**
+	 * @brief Adds a BezierCurve or BSpline in world space.
+	 * @return index of the curve, -1 if the model is not a supported curve.
+	 */
+	int AddModel(ModelBase* model);
+
+	inline int GetCurveCount() const {
+		return m_curveCount;
+	}
+
+	/**
+	 * @brief Every intersection closer than tolerance.
+	 * @param curve if not negative, only the intersections of this curve are computed.
+	 */
+	std::vector<CurveIntersection> Intersect(float tolerance, int curve = -1) const;
+
+	/**
+	 * @brief Intersections of model with every other curve of models in world space, logged to the console.
+	 * @return the number of intersections.
+	 */
+	static int IntersectWithScene(ModelBase* model, const std::vector<ModelBase*>& models, float tolerance);
+};
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Result of projecting a point onto a curve.
+ */
+struct CurveProjection {
+	float t = 0;				// curve parameter of the foot point
+	float distance = 0;
+	glm::vec3 point{};			// foot point on the curve
+};
+
+/**
+ * @brief Closest point queries on a piecewise Bezier curve, without any GL dependency.
+ * Span i is defined on [breaks[i], breaks[i+1]] of the curve parameter, like in ArcLengthTable.
+ * Every span is subdivided until its control polygon is flat, the pieces form a tree of bounding boxes.
+ * A query walks the tree nearest box first, skips the boxes farther than the best distance found so far,
+ * and refines the parameter with Newton iterations inside the remaining pieces.
+ * Spans of rational curves have homogeneous control points, they are evaluated with the quotient rule.
+ */
+class CurveProjector {
+protected:
+	static constexpr int MAX_DEPTH = 12;
+	static constexpr int NEWTON_ITERATIONS = 8;
+	static constexpr float FLATNESS = 1e-3f;	// relative to the size of the span
+	static constexpr size_t MIN_POINTS_PER_THREAD = 256;
+
+	struct Span {
+		std::vector<glm::vec4> points;
+		std::vector<glm::vec4> d1;		// first hodograph
+		std::vector<glm::vec4> d2;		// second hodograph
+		bool rational = false;
+		float start = 0;
+		float end = 1;
+
+		glm::vec3 Evaluate(float t) const;
+		/**
+		 * @brief Point and first two derivatives at t.
+		 */
+		void Evaluate(float t, glm::vec3& c, glm::vec3& c1, glm::vec3& c2) const;
+	};
+	struct Node {
+		glm::vec3 min{};
+		glm::vec3 max{};
+		int span = 0;
+		float t0 = 0;			// local parameter range of the piece
+		float t1 = 1;
+		int children[2] = { -1, -1 };
+	};
+
+	std::vector<Span> m_spans{};
+	std::vector<Node> m_nodes{};
+	std::vector<int> m_roots{};
+
+	int BuildNode(int span, const std::vector<glm::vec4>& piece, float t0, float t1, float tolerance, int depth);
+	void Refine(const Span& span, const glm::vec3& p, float t0, float t1, float& bestT, float& bestDistance2) const;
+	void ProjectRange(const glm::vec3* points, size_t count, CurveProjection* out) const;
+
+public:
+	CurveProjector() = default;
+	/**
+	 * @param spans control points of the Bezier spans
+	 * @param breaks spans.size() + 1 increasing parameter values
+	 */
+	CurveProjector(const std::vector<std::vector<glm::vec4>>& spans, const std::vector<float>& breaks);
+
+	inline bool IsEmpty() const {
+		return m_spans.empty();
+	}
+
+	/**
+	 * @brief Closest point of the curve to p.
+	 */
+	CurveProjection Project(const glm::vec3& p) const;
+	/**
+	 * @brief Projects count points, split among threadCount threads (0: one per hardware thread).
+	 * Small batches are processed on the calling thread.
+	 */
+	void Project(const glm::vec3* points, size_t count, CurveProjection* out, int threadCount = 0) const;
+	std::vector<CurveProjection> Project(const std::vector<glm::vec3>& points, int threadCount = 0) const;
+};
\ No newline at end of file
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "../include_all.h"
+
+namespace CurveTessellation {
+
+	// above this degree the accumulated error of forward differencing becomes visible
+	constexpr int FORWARD_DIFFERENCING_MAX_DEGREE = 3;
+	constexpr float EPSILON = 1e-6f;
+
+	/**
+	 * @brief Settings of the flatness driven (adaptive) tessellation.
+	 */
+	struct AdaptiveParams {
+		float tolerance = 0.01f;		// max distance of the control polygon from its chord
+		bool screenSpace = false;		// measure the tolerance in pixels, after projecting with viewProj
+		glm::mat4 viewProj = glm::identity<glm::mat4>();
+		glm::vec2 viewport = glm::vec2(1);
+		int maxDepth = 16;				// max number of halvings of a segment
+	};
+
+	/**
+	 * @brief Evaluates a Bezier curve at a single parameter value in double precision (de Casteljau).
+	 */
+	inline glm::dvec4 DeCasteljau(const std::vector<glm::vec4>& ctrlPoints, double t) {
+		std::vector<glm::dvec4> col(ctrlPoints.begin(), ctrlPoints.end());
+		for (int r = col.size() - 1; r > 0; --r) {
+			for (int k = 0; k < r; ++k) {
+				col[k] = (1.0 - t) * col[k] + t * col[k + 1];
+			}
+		}
+		return col[0];
+	}
+
+	/**
+	 * @brief Tessellates the curve into division points by stepping its difference table.
+	 * Costs O(n) additions per point after an O(n^2) setup.
+	 */
+	inline void ForwardDifferencing(const std::vector<glm::vec4>& ctrlPoints, int division, std::vector<glm::vec4>& out) {
+		int n = ctrlPoints.size() - 1;
+		double h = 1.0 / double(division - 1);
+
+		// exact values at 0, h, ..., n*h turned into the forward differences of P(0)
+		std::vector<glm::dvec4> d(n + 1);
+		for (int i = 0; i <= n; ++i) {
+			d[i] = DeCasteljau(ctrlPoints, i * h);
+		}
+		for (int k = 1; k <= n; ++k) {
+			for (int i = n; i >= k; --i) {
+				d[i] -= d[i - 1];
+			}
+		}
+
+		out.resize(division);
+		out[0] = glm::vec4(d[0]);
+		for (int i = 1; i < division; ++i) {
+			for (int k = 0; k < n; ++k) {
+				d[k] += d[k + 1];
+			}
+			out[i] = glm::vec4(d[0]);
+		}
+		// the curve interpolates its last control point, avoid the drift there
+		out[division - 1] = ctrlPoints[n];
+	}
+
+	/**
+	 * @brief Tessellates the curve into division points as a product of the Bernstein table
+	 * and the control points.
+	 */
+	inline void BernsteinSum(const std::vector<glm::vec4>& ctrlPoints, int division, std::vector<glm::vec4>& out) {
+		int n = ctrlPoints.size() - 1;
+		const BernsteinTable& table = BernsteinTableCache::Get(n, division);
+
+		out.resize(division);
+		for (int i = 0; i < division; ++i) {
+			const double* row = &table.weights[i * (n + 1)];
+			glm::dvec4 p(0);
+			for (int k = 0; k <= n; ++k) {
+				p += row[k] * glm::dvec4(ctrlPoints[k]);
+			}
+			out[i] = glm::vec4(p);
+		}
+	}
+
+	/**
+	 * @brief Splits a Bezier curve at t into two curves of the same degree (de Casteljau).
+	 */
+	inline void SplitBezier(const std::vector<glm::vec4>& ctrlPoints, float t, std::vector<glm::vec4>& left, std::vector<glm::vec4>& right) {
+		int n = ctrlPoints.size() - 1;
+		std::vector<glm::vec4> col = ctrlPoints;
+		left.resize(n + 1);
+		right.resize(n + 1);
+		for (int i = 0; i <= n; ++i) {
+			left[i] = col[0];
+			right[n - i] = col[n - i];
+			for (int j = 0; j < n - i; ++j) {
+				col[j] = (1 - t) * col[j] + t * col[j + 1];
+			}
+		}
+	}
+
+	/**
+	 * @brief Checks if every control point is within the tolerance from the chord, the curve
+	 * stays in the convex hull of its control points, so the chord is then close enough to it.
+	 * Homogeneous control points of rational curves are projected first, with positive weights the curve
+	 * stays in the convex hull of the projected points as well.
+	 */
+	inline bool IsFlat(const std::vector<glm::vec4>& ctrlPoints, const AdaptiveParams& params) {
+		std::vector<glm::vec3> q(ctrlPoints.size());
+		for (int i = 0; i < ctrlPoints.size(); ++i) {
+			if (params.screenSpace) {
+				glm::vec4 clip = params.viewProj * ctrlPoints[i];
+				// behind the camera, there is no visible error to measure
+				if (clip.w < EPSILON) {
+					return true;
+				}
+				q[i] = glm::vec3(glm::vec2(clip.x, clip.y) / clip.w * 0.5f * params.viewport, 0);
+			}
+			else {
+				q[i] = glm::vec3(BezierAlgorithms::Dehomogenize(ctrlPoints[i]));
+			}
+		}
+
+		glm::vec3 a = q.front();
+		glm::vec3 d = q.back() - a;
+		float len2 = glm::dot(d, d);
+		for (int i = 1; i < q.size() - 1; ++i) {
+			// distance from the chord segment
+			float s = len2 > EPSILON ? glm::clamp(glm::dot(q[i] - a, d) / len2, 0.f, 1.f) : 0.f;
+			if (glm::length(q[i] - (a + s * d)) > params.tolerance) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	inline void AdaptiveBezierRecursive(const std::vector<glm::vec4>& ctrlPoints, const AdaptiveParams& params, int depth, std::vector<glm::vec4>& out) {
+		if (depth >= params.maxDepth || IsFlat(ctrlPoints, params)) {
+			out.push_back(ctrlPoints.back());
+			return;
+		}
+		std::vector<glm::vec4> left, right;
+		SplitBezier(ctrlPoints, 0.5f, left, right);
+		AdaptiveBezierRecursive(left, params, depth + 1, out);
+		AdaptiveBezierRecursive(right, params, depth + 1, out);
+	}
+
+	/**
+	 * @brief Tessellates a Bezier curve by halving it until every piece is flat within the tolerance.
+	 * Appends the points to out, the first point is skipped if it equals the last point of out.
+	 */
+	inline void AdaptiveBezier(const std::vector<glm::vec4>& ctrlPoints, const AdaptiveParams& params, std::vector<glm::vec4>& out) {
+		if (ctrlPoints.empty()) {
+			Log::errorToConsole("CurveTessellation::AdaptiveBezier no control points");
+			return;
+		}
+		if (out.empty() || out.back() != ctrlPoints.front()) {
+			out.push_back(ctrlPoints.front());
+		}
+		if (ctrlPoints.size() > 1) {
+			AdaptiveBezierRecursive(ctrlPoints, params, 0, out);
+		}
+	}
+
+	/**
+	 * @brief Tessellates a B-Spline into division points uniformly spaced over its domain,
+	 * the same points the B-Spline shader generates. Rational curves are projected from their homogeneous control points.
+	 */
+	inline void TessellateBSpline(int p, const std::vector<float>& knots, const std::vector<glm::vec4>& ctrlPoints, int division, std::vector<glm::vec4>& out) {
+		out.clear();
+		if (!BSplineAlgorithms::IsValid(p, knots, ctrlPoints) || division < 2) {
+			Log::errorToConsole("CurveTessellation::TessellateBSpline invalid input");
+			return;
+		}
+		float tStart = knots[p];
+		float tEnd = knots[ctrlPoints.size()];
+		float deltaT = (tEnd - tStart) / float(division - 1);
+		out.resize(division);
+		for (int i = 0; i < division; ++i) {
+			out[i] = BezierAlgorithms::Dehomogenize(BSplineAlgorithms::CurvePoint(p, knots, ctrlPoints, tStart + deltaT * float(i)));
+		}
+	}
+
+	/**
+	 * @brief Re-evaluates the points of TessellateBSpline that control points [firstCtrlPoint, lastCtrlPoint) influence,
+	 * bit-identical to the full tessellation. Moving a control point changes only the p + 1 spans of its support.
+	 * @param first index of out[0] among the division points.
+	 */
+	inline void TessellateBSplineSpans(int p, const std::vector<float>& knots, const std::vector<glm::vec4>& ctrlPoints, int division,
+		int firstCtrlPoint, int lastCtrlPoint, std::vector<glm::vec4>& out, int& first) {
+		out.clear();
+		first = 0;
+		if (!BSplineAlgorithms::IsValid(p, knots, ctrlPoints) || division < 2
+			|| firstCtrlPoint < 0 || lastCtrlPoint > ctrlPoints.size() || firstCtrlPoint >= lastCtrlPoint) {
+			Log::errorToConsole("CurveTessellation::TessellateBSplineSpans invalid input");
+			return;
+		}
+		float tStart = knots[p];
+		float tEnd = knots[ctrlPoints.size()];
+		float deltaT = (tEnd - tStart) / float(division - 1);
+		// N_first ... N_{last-1} are nonzero on [u_first, u_{last+p}], one more point on both sides against rounding
+		float tFrom = knots[firstCtrlPoint];
+		float tTo = knots[lastCtrlPoint + p];
+		int last = division - 1;
+		if (deltaT > 0.f) {
+			first = glm::clamp(int(std::floor((tFrom - tStart) / deltaT)) - 1, 0, division - 1);
+			last = glm::clamp(int(std::ceil((tTo - tStart) / deltaT)) + 1, first, division - 1);
+		}
+		out.resize(last - first + 1);
+		for (int i = first; i <= last; ++i) {
+			out[i - first] = BezierAlgorithms::Dehomogenize(BSplineAlgorithms::CurvePoint(p, knots, ctrlPoints, tStart + deltaT * float(i)));
+		}
+	}
+
+	/**
+	 * @brief Tessellates a B-Spline by splitting it into Bezier segments with knot insertion,
+	 * then subdividing each segment until it is flat within the tolerance.
+	 * The segments of a rational curve are split in homogeneous form, only the output points are projected.
+	 */
+	inline void AdaptiveBSpline(int p, const std::vector<float>& knots, const std::vector<glm::vec4>& ctrlPoints, const AdaptiveParams& params, std::vector<glm::vec4>& out) {
+		out.clear();
+		for (const auto& segment : BSplineAlgorithms::DecomposeToBezier(p, knots, ctrlPoints)) {
+			AdaptiveBezier(segment, params, out);
+		}
+		for (auto& point : out) {
+			point = BezierAlgorithms::Dehomogenize(point);
+		}
+	}
+
+	/**
+	 * @brief Tessellates a Bezier curve into division points uniformly spaced in the parameter,
+	 * the same points the Bezier curve shader generates.
+	 */
+	inline void TessellateBezier(const std::vector<glm::vec4>& ctrlPoints, int division, std::vector<glm::vec4>& out) {
+		if (ctrlPoints.empty() || division < 2) {
+			Log::errorToConsole("CurveTessellation::TessellateBezier invalid input");
+			out.clear();
+			return;
+		}
+		if (ctrlPoints.size() - 1 <= FORWARD_DIFFERENCING_MAX_DEGREE) {
+			ForwardDifferencing(ctrlPoints, division, out);
+		}
+		else {
+			BernsteinSum(ctrlPoints, division, out);
+		}
+	}
+}
\ No newline at end of file
@@ -9,6 +9,52 @@ protected:
 	bool m_ctrlPointsDirty = false;
 	glm::vec3 m_color = { 1.f, 0, 1.f };
 
+	ArcLengthTable m_arcLengthTable{};		// parameter i is the i-th point
+	bool m_arcLengthDirty = true;
+
+	PolylineSimplifier m_simplifier{};		// levels of detail of the untransformed points
+	bool m_lodDirty = true;					// the levels have to be rebuilt
+	bool m_lodIndexDirty = true;			// the element buffer is older than the levels
+	bool m_levelOfDetail = true;
+	float m_lodPixelError = 1.f;
+	GLuint m_lodVAOID = 0;					// element buffer of the levels, gl_VertexID is the point index
+	GLuint m_lodIndexBufferID = 0;
+	int m_lodIndexCapacity = 0;
+	int m_lodLevel = 0;						// level drawn in the last frame
+
+	PolylineGeometry m_geometry{};			// frames, curvature and torsion of the untransformed points
+	bool m_geometryDirty = true;
+	CurveColormap m_colormap = CurveColormap::None;
+	bool m_colormapDirty = true;			// the scalar SSBO does not hold the mapped quantity yet
+	GLuint m_scalarsSSBOID = 0;
+	int m_scalarsCapacity = 0;
+	glm::vec2 m_colormapRange{ 0, 1 };		// values mapped to the ends of the colormap
+
+	// streaming: the points are appended to a persistently mapped ring of twice the history, the shader reads
+	// the window of the last m_historySize points modulo the ring, so an append writes only the new points
+	bool m_streaming = false;
+	GLuint m_ringSSBOID = 0;
+	glm::vec4* m_ringMapped = nullptr;		// coherent, write-only
+	std::vector<glm::vec4> m_ringPoints{};	// CPU copy of the ring for the queries
+	int m_ringCapacity = 0;
+	int m_historySize = 0;
+	size_t m_streamStart = 0;				// sequence numbers of the first and one past the last point of the window,
+	size_t m_streamEnd = 0;					// point s is in slot s % m_ringCapacity
+	std::deque<std::pair<GLsync, size_t>> m_ringFences{};		// frames in flight and the first point they read
+	std::unique_ptr<PointQueue> m_streamQueue{};
+	bool m_streamPointsDirty = false;		// m_ctrlPoints does not hold the window yet
+	int m_streamHistoryGUI = 100000;
+
+	void WriteLodIndexBuffer();
+	float GetPixelsPerUnit(RenderParams* p) const;
+	void SetCurveUniforms(GLuint progID) const;
+	void WriteScalarsSSBO();
+
+	void WaitForRing(size_t lastPoint);
+	void FenceRing();
+	void ReleaseRing();
+	void SyncStreamedPoints();
+
 	void SetCtrlPointsSSBO() {
 		glGenBuffers(1, &m_ctrlPointsSSBOID);
 		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ctrlPointsSSBOID);
@@ -54,37 +100,66 @@ public:
 	}
 
 	inline void AddCtrlPoint(glm::vec3 newPoint) {
+		if (m_streaming) {
+			glm::vec4 point(newPoint, 1);
+			StreamPoints(&point, 1);
+			return;
+		}
 		m_ctrlPoints.push_back(glm::vec4(newPoint, 1));
 		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_lodDirty = true;
+		m_geometryDirty = true;
 	}
 	inline void DelCtrlPoint(int index) {
+		if (m_streaming) {
+			Log::errorToConsole("DiscreteCurve::DelCtrlPoint not available while streaming, call EndStream first");
+			return;
+		}
 		if (index < 0 || index > m_ctrlPoints.size() - 1) {
 			Log::errorToConsole("Bezier::DelCtrlPoint invalid index");
 			return;
 		}
 		m_ctrlPoints.erase(m_ctrlPoints.begin() + index);
 		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_lodDirty = true;
+		m_geometryDirty = true;
 	}
 	inline void SetCtrlPoint(int index, glm::vec3 position) {
+		if (m_streaming) {
+			Log::errorToConsole("DiscreteCurve::SetCtrlPoint not available while streaming, call EndStream first");
+			return;
+		}
 		if (index < 0 || index > m_ctrlPoints.size() - 1) {
 			Log::errorToConsole("Bezier::SetCtrlPoint invalid index");
 			return;
 		}
 		m_ctrlPoints[index] = glm::vec4(position, 1);
 		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_lodDirty = true;
+		m_geometryDirty = true;
 	}
 	inline void SetCtrlPoints(std::vector<glm::vec4> points) {
+		if (m_streaming) {
+			// restart the window, the ring slots are reused through the fences
+			m_streamStart = m_streamEnd;
+			StreamPoints(points.data(), points.size());
+			return;
+		}
 		m_ctrlPoints = points;
 		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_lodDirty = true;
+		m_geometryDirty = true;
 	}
-	inline std::vector<glm::vec4> GetCtrlPoints() const {
-		return m_ctrlPoints;
-	}
+	std::vector<glm::vec4> GetCtrlPoints() const;
 	inline int GetCtrlPointCount() const {
-		return m_ctrlPoints.size();
+		return m_streaming ? int(m_streamEnd - m_streamStart) : m_ctrlPoints.size();
 	}
 	inline GLuint GetCtrlPointsSSBO() const {
-		return m_ctrlPointsSSBOID;
+		return m_streaming ? m_ringSSBOID : m_ctrlPointsSSBOID;
 	}
 	inline void SetApplyTransforms(bool apply) {
 		m_applyTransforms = apply;
@@ -103,4 +178,87 @@ public:
 		return m_color;
 	}
 
+	/**
+	 * @brief Draws the coarsest simplified level whose error stays below pixelError pixels at the current camera,
+	 * see PolylineSimplifier. The hierarchy is rebuilt when the points change.
+	 */
+	inline void SetLevelOfDetail(bool enabled, float pixelError) {
+		m_levelOfDetail = enabled;
+		m_lodPixelError = glm::max(pixelError, 0.f);
+	}
+	inline bool GetLevelOfDetail() const {
+		return m_levelOfDetail;
+	}
+	inline float GetLodPixelError() const {
+		return m_lodPixelError;
+	}
+	inline int GetLodLevel() const {
+		return m_lodLevel;
+	}
+	/**
+	 * @brief Switches to streaming: the curve keeps only the last historySize points in a persistently mapped
+	 * ring buffer, appends write only the new points and the transformation is applied in the shader.
+	 * Ring slots still read by frames in flight are protected by fences, a wait happens only if more than
+	 * historySize points arrive while a frame is in flight. The current points become the start of the stream.
+	 * Calling it again changes the history size. Level of detail is off while streaming.
+	 * @param queueCapacity Capacity of the queue returned by GetStreamQueue.
+	 */
+	bool BeginStream(int historySize, int queueCapacity = 1 << 16);
+	/**
+	 * @brief Leaves streaming, the window of the stream becomes the control points.
+	 */
+	void EndStream();
+	inline bool IsStreaming() const {
+		return m_streaming;
+	}
+	inline int GetHistorySize() const {
+		return m_historySize;
+	}
+	/**
+	 * @brief Appends points on the GL thread, while streaming only the new points are written to the ring,
+	 * otherwise they are added to the control points.
+	 */
+	void StreamPoints(const glm::vec4* points, size_t count);
+	/**
+	 * @brief Queue of the streamed points for one producer thread that must not call GL, Render appends its content.
+	 * nullptr if not streaming. The queue lives until EndStream or the next BeginStream, stop the producer before those.
+	 */
+	inline PointQueue* GetStreamQueue() {
+		return m_streamQueue.get();
+	}
+
+	/**
+	 * @brief Simplification hierarchy of the untransformed points, rebuilt if the points changed.
+	 */
+	const PolylineSimplifier& GetSimplifier();
+
+	/**
+	 * @brief Tangents, normals, binormals, curvatures and torsions at the untransformed points,
+	 * recomputed in parallel if the points changed, see PolylineGeometry.
+	 */
+	const PolylineGeometry& GetGeometry();
+	/**
+	 * @brief Colors the curve by a quantity of GetGeometry, mapped over its range at the points.
+	 * The values are uploaded once after every change of the points, not every frame. Off while streaming.
+	 */
+	inline void SetColormap(CurveColormap colormap) {
+		m_colormap = colormap;
+		m_colormapDirty = true;
+	}
+	inline CurveColormap GetColormap() const {
+		return m_colormap;
+	}
+	inline glm::vec2 GetColormapRange() const {
+		return m_colormapRange;
+	}
+
+	/**
+	 * @brief Arc-length table of the untransformed polyline, rebuilt if the points changed.
+	 */
+	ArcLengthTable& GetArcLengthTable();
+	/**
+	 * @brief Point of the untransformed polyline at arc length s from the start.
+	 */
+	glm::vec4 GetPointAtLength(float s);
+
 };
\ No newline at end of file
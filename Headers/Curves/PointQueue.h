@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Lock-free single-producer single-consumer queue of points.
+ * One thread pushes, for example a worker reading measurement data, and the render thread consumes,
+ * neither of them blocks and the producer never touches GL. The capacity is rounded up to a power of two,
+ * points pushed into a full queue are rejected and counted as dropped.
+ */
+class PointQueue {
+protected:
+	std::vector<glm::vec4> m_points{};
+	size_t m_mask = 0;
+	// the producer and the consumer write different cache lines
+	alignas(64) std::atomic<size_t> m_head{ 0 };		// next slot to write, stored only by the producer
+	alignas(64) std::atomic<size_t> m_tail{ 0 };		// next slot to read, stored only by the consumer
+	alignas(64) std::atomic<size_t> m_dropped{ 0 };
+
+public:
+	PointQueue(size_t capacity);
+	PointQueue(const PointQueue&) = delete;
+	PointQueue& operator=(const PointQueue&) = delete;
+
+	/**
+	 * @brief Producer side, returns false if the queue is full.
+	 */
+	inline bool Push(const glm::vec4& point) {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (head - m_tail.load(std::memory_order_acquire) >= m_points.size()) {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		m_points[head & m_mask] = point;
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+	/**
+	 * @brief Producer side, pushes as many points as fit with one publish, returns their number.
+	 */
+	size_t Push(const glm::vec4* points, size_t count);
+
+	/**
+	 * @brief Consumer side, hands every queued point to f(const glm::vec4* points, size_t count)
+	 * in at most two contiguous runs without copying them, then frees the slots. Returns the number of points.
+	 */
+	template <typename F>
+	size_t Consume(F f) {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		size_t count = m_head.load(std::memory_order_acquire) - tail;
+		if (count == 0) {
+			return 0;
+		}
+		size_t first = tail & m_mask;
+		size_t run = std::min(count, m_points.size() - first);
+		f(m_points.data() + first, run);
+		if (run < count) {
+			f(m_points.data(), count - run);
+		}
+		m_tail.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	/**
+	 * @brief Number of queued points, only a snapshot while the other thread is running.
+	 */
+	inline size_t GetSize() const {
+		return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+	}
+	inline size_t GetCapacity() const {
+		return m_points.size();
+	}
+	inline size_t GetDroppedCount() const {
+		return m_dropped.load(std::memory_order_relaxed);
+	}
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Discrete differential geometry of a polyline: Frenet frame, curvature and torsion at every vertex.
+ * The positions are stored in structure-of-arrays form, so every vertex is computed from its two edges
+ * on 8 (AVX) or 4 (SSE) vertices at once, with a scalar fallback for the rest, and the vertex range is split
+ * between threads.
+ * - tangent: bisector of the two edge directions
+ * - curvature: Menger curvature, the inverse radius of the circle through the vertex and its neighbours
+ * - binormal: normalized cross product of the edges, normal = binormal x tangent
+ * - torsion: -dB/ds . N from the binormals of the neighbours, central difference over the two edges
+ * Where the edges are parallel the binormal is undefined, the frame of the previous vertex is carried over
+ * by projecting its binormal onto the normal plane, the end points take the values of their neighbours.
+ */
+class PolylineGeometry {
+public:
+	/**
+	 * @brief Vectors in structure-of-arrays form.
+	 */
+	struct VectorArray {
+		std::vector<float> x{};
+		std::vector<float> y{};
+		std::vector<float> z{};
+
+		inline glm::vec3 operator[](size_t i) const {
+			return glm::vec3(x[i], y[i], z[i]);
+		}
+		inline void Set(size_t i, const glm::vec3& v) {
+			x[i] = v.x;
+			y[i] = v.y;
+			z[i] = v.z;
+		}
+		inline void Resize(size_t size) {
+			x.assign(size, 0.f);
+			y.assign(size, 0.f);
+			z.assign(size, 0.f);
+		}
+		inline size_t Size() const {
+			return x.size();
+		}
+	};
+
+protected:
+	static constexpr size_t MIN_POINTS_PER_THREAD = 4096;
+	static constexpr float PARALLEL_SINE = 1e-6f;	// the edges are parallel below this sine of their angle
+
+	VectorArray m_points{};
+	VectorArray m_tangents{};
+	VectorArray m_normals{};
+	VectorArray m_binormals{};
+	std::vector<float> m_curvatures{};
+	std::vector<float> m_torsions{};
+
+	// the kernels process the vertices first .. first + count - 1, all of them inner vertices,
+	// and return the number of vertices they have processed
+	size_t FramesScalar(size_t first, size_t count);
+	size_t TorsionScalar(size_t first, size_t count);
+#ifdef SIMD_SSE
+	size_t FramesSSE(size_t first, size_t count);
+	size_t TorsionSSE(size_t first, size_t count);
+#endif
+#ifdef SIMD_AVX
+	size_t FramesAVX(size_t first, size_t count);
+	size_t TorsionAVX(size_t first, size_t count);
+#endif
+	void FramesRange(size_t first, size_t count);
+	void TorsionRange(size_t first, size_t count);
+	/**
+	 * @brief Carries the frames over the vertices with parallel edges and sets the end points, sequential.
+	 */
+	void FillDegenerateFrames();
+
+public:
+	PolylineGeometry() = default;
+
+	/**
+	 * @brief Computes every quantity of the polyline through the xyz of the points.
+	 * @param threadCount Number of threads, 0 uses every hardware thread.
+	 */
+	void Compute(const std::vector<glm::vec4>& points, int threadCount = 0);
+	void Clear();
+
+	inline size_t GetPointCount() const {
+		return m_points.Size();
+	}
+	inline const VectorArray& GetTangents() const {
+		return m_tangents;
+	}
+	inline const VectorArray& GetNormals() const {
+		return m_normals;
+	}
+	inline const VectorArray& GetBinormals() const {
+		return m_binormals;
+	}
+	inline const std::vector<float>& GetCurvatures() const {
+		return m_curvatures;
+	}
+	inline const std::vector<float>& GetTorsions() const {
+		return m_torsions;
+	}
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Simplification hierarchy of a polyline, built once in O(N log N) with Visvalingam-Whyatt elimination.
+ * The inner points are removed one by one from a binary heap, always the one whose removal adds the least error:
+ * its distance from the chord of its two remaining neighbours plus the error already collected by the two segments.
+ * That error at its removal, made monotone along the removal order, is the importance of the point and bounds
+ * the distance of every removed point from the simplified polyline. The simplification for a tolerance keeps
+ * the points whose importance is above it, so any tolerance can be extracted without running the elimination again.
+ * The end points are always kept.
+ *
+ * Levels: level 0 is the full polyline, every further level keeps about half of the points of the previous one,
+ * down to MIN_LEVEL_POINTS. The point indices of levels 1 ... are stored one level after the other,
+ * less than N indices in total, ready to be uploaded into one element buffer.
+ */
+class PolylineSimplifier {
+public:
+	struct Level {
+		int first = 0;			// offset of the level in GetIndices(), -1 for level 0 which draws every point
+		int count = 0;			// number of points
+		float error = 0;		// largest importance of the removed points, bounds their distance from the level
+	};
+
+protected:
+	static constexpr int MIN_LEVEL_POINTS = 64;
+
+	std::vector<float> m_importance{};
+	std::vector<GLuint> m_indices{};
+	std::vector<Level> m_levels{};
+	glm::vec3 m_min{};			// bounding box of the points
+	glm::vec3 m_max{};
+
+public:
+	PolylineSimplifier() = default;
+
+	/**
+	 * @brief Ranks the points and builds the levels.
+	 */
+	void Build(const std::vector<glm::vec4>& points);
+
+	inline bool IsEmpty() const {
+		return m_importance.empty();
+	}
+	inline int GetPointCount() const {
+		return m_importance.size();
+	}
+	inline float GetImportance(int index) const {
+		return m_importance[index];
+	}
+	inline int GetLevelCount() const {
+		return m_levels.size();
+	}
+	inline const Level& GetLevel(int level) const {
+		return m_levels[level];
+	}
+	inline const std::vector<GLuint>& GetIndices() const {
+		return m_indices;
+	}
+	inline glm::vec3 GetMin() const {
+		return m_min;
+	}
+	inline glm::vec3 GetMax() const {
+		return m_max;
+	}
+
+	/**
+	 * @brief Coarsest level whose error is within tolerance.
+	 */
+	int SelectLevel(float tolerance) const;
+	/**
+	 * @brief Indices of the points kept for an arbitrary tolerance, in O(N).
+	 */
+	void Extract(float tolerance, std::vector<GLuint>& out) const;
+};
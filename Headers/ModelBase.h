@@ -31,7 +31,14 @@ protected:
 	static inline float m_shearY = 0;
 	static inline float m_shearZ = 0;
 	static inline float m_bezierCutParam = 0;
+	static inline int m_bezierCutCount = 1;
+	static inline int m_bezierTargetDegree = 1;
+	static inline float m_bezierDegreeDeviation = 0;
 	static inline float m_newKnot = 0;
+	static inline float m_knotRemovalTolerance = 0.001f;
+	static inline int m_removedKnotCount = 0;
+	static inline float m_intersectionTolerance = 0.001f;
+	static inline int m_intersectionCount = 0;
 
 	static inline glm::vec3 m_curveColor{ 1, 0, 1 };
 	static inline glm::vec3 m_bezierNewCtrlPoint{ 0, 0, 0 };
@@ -68,6 +68,7 @@ protected:
 	GLuint m_programBSplineSelectedID = 0;			// Draw BSpline-curve selection
 	GLuint m_programBezierSurfaceID = 0;			// Draw Bezier-surface
 	GLuint m_programBezierSurfaceSelectedID = 0;	// Draw Bezier-surface selection
+	GLuint m_programBezierSurfaceGridID = 0;		// Evaluate Bezier-surface sample grid
 	GLuint m_programShadowID = 0;					// Render shadow texture
 
 	GLuint m_programDirectionLightID = 0;			// Render direction light selection
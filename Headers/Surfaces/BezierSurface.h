@@ -10,10 +10,31 @@ protected:
 	glm::ivec2 m_dim{ 0, 0 };
 	GLuint m_ctrlPointsSSBOID = 0;
 	bool m_ctrlPointsDirty = false;
+	GLuint m_coefficientsSSBOID = 0;		// scaled Bernstein coefficients for Horner evaluation
+	bool m_hornerEvaluation = true;
 	GLuint m_interpolatedPointsSSBOID = 0;
 	glm::ivec2 m_smoothness{10, 10};
 	bool m_wireframe = false;
 
+	// grid of samples evaluated in two separable stages, see BezierSurfaceEvaluator
+	SurfaceEvaluation m_evaluation = SurfaceEvaluation::Compute;
+	GLuint m_gridProgramID = 0;
+	BezierSurfaceEvaluator m_evaluator{};
+	bool m_gridDirty = true;
+	bool m_gridValid = false;				// the grid SSBO holds every sample of the current division
+	GLuint m_gridSSBOID = 0;				// point and normal of every sample
+	GLuint m_curvesSSBOID = 0;				// first stage of the compute pass
+	int m_gridCapacity = 0;
+	int m_curvesCapacity = 0;
+	// indexed drawing of the grid, gl_VertexID is the sample index
+	GLuint m_gridVAOID = 0;
+	GLuint m_gridIndexBufferID = 0;		// owned by GridIndexCache
+
+	/**
+	 * @brief Evaluates the sample grid on the CPU or in the compute pass, returns false if there is no valid grid.
+	 */
+	bool UpdateGrid();
+
 	void SetCtrlPointsSSBO() {
 		glGenBuffers(1, &m_ctrlPointsSSBOID);
 		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ctrlPointsSSBOID);
@@ -37,6 +58,20 @@ protected:
 			newPoints.size() * sizeof(glm::vec4),
 			newPoints.data(),
 			GL_STATIC_DRAW);
+		WriteCoefficientsSSBO(newPoints);
+	}
+	void WriteCoefficientsSSBO(const std::vector<glm::vec4>& points) {
+		if (m_coefficientsSSBOID == 0) {
+			glCreateBuffers(1, &m_coefficientsSSBOID);
+		}
+		if (points.empty() || points.size() != GetRowsCount() * GetColsCount()) {
+			return;
+		}
+		std::vector<glm::vec4> coefficients = BezierAlgorithms::ScaledBernsteinSurface(points, GetRowsCount(), GetColsCount());
+		glNamedBufferData(m_coefficientsSSBOID,
+			coefficients.size() * sizeof(glm::vec4),
+			coefficients.data(),
+			GL_STATIC_DRAW);
 	}
 	void SetInterpolatedPointsSSBO() {
 		glGenBuffers(1, &m_interpolatedPointsSSBOID);
@@ -78,7 +113,29 @@ public:
 		return m_wireframe;
 	}
 
+	inline void SetHornerEvaluation(bool horner) {
+		m_hornerEvaluation = horner;
+	}
+	inline bool GetHornerEvaluation() const {
+		return m_hornerEvaluation;
+	}
+
+	/**
+	 * @brief Shader evaluates every vertex in the vertex shader, CPU and Compute evaluate the sample grid once
+	 * in two separable stages and rebuild it only when the control points, the transformation or the smoothness change.
+	 */
+	inline void SetSurfaceEvaluation(SurfaceEvaluation evaluation) {
+		m_evaluation = evaluation;
+		m_gridDirty = true;
+	}
+	inline SurfaceEvaluation GetSurfaceEvaluation() const {
+		return m_evaluation;
+	}
+
 	inline void SetSmoothness(glm::vec2 smoothness) {
+		if (glm::ivec2(smoothness) != m_smoothness) {
+			m_gridDirty = true;
+		}
 		m_smoothness = smoothness;
 	}
 	inline glm::ivec2 GetSmoothness() const {
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Separable evaluation of a tensor-product Bezier surface on its grid of samples, without any GL dependency.
+ * The control points are row-major, u runs along the columns (degree cols - 1) and v along the rows (degree rows - 1),
+ * sample i of a direction is at i / (division - 1), like in the BezierSurface shaders.
+ * Stage one evaluates every row as a curve of u at every u sample, the point and its u derivative,
+ * so rows * cols work per u sample instead of per vertex. Stage two combines the rows curves of the
+ * u sample of a vertex with the degree rows - 1 basis in v, which gives the point and both partial derivatives.
+ * Comp_BezierSurfaceGrid runs the same two stages on the GPU with the same buffer layouts.
+ */
+class BezierSurfaceEvaluator {
+protected:
+	int m_rows = 0;
+	int m_cols = 0;
+	glm::ivec2 m_division{ 0, 0 };
+	std::vector<glm::vec4> m_curves{};		// stage one: point, u derivative at 2 * (u index * rows + row)
+	std::vector<glm::vec4> m_grid{};		// stage two: point, normal at 2 * (v index * division.x + u index)
+
+public:
+	BezierSurfaceEvaluator() = default;
+
+	/**
+	 * @brief Runs both stages, returns false if the control points do not match the dimensions.
+	 * @param division Number of samples in u and v, at least 2 each.
+	 */
+	bool Build(const std::vector<glm::vec4>& ctrlPoints, int rows, int cols, glm::ivec2 division);
+	/**
+	 * @brief Stage one only, the point and u derivative of every row at every u sample.
+	 */
+	bool BuildCurves(const std::vector<glm::vec4>& ctrlPoints, int rows, int cols, int divisionU);
+	/**
+	 * @brief Stage two only, on the curves of the last BuildCurves with divisionV samples in v.
+	 */
+	void EvaluateGrid(int divisionV);
+
+	inline bool IsEmpty() const {
+		return m_grid.empty();
+	}
+	inline glm::ivec2 GetDivision() const {
+		return m_division;
+	}
+	inline const std::vector<glm::vec4>& GetCurves() const {
+		return m_curves;
+	}
+	/**
+	 * @brief Point (w = 1) and unit normal (w = 0) of every sample, the layout of the grid SSBO.
+	 */
+	inline const std::vector<glm::vec4>& GetGrid() const {
+		return m_grid;
+	}
+	inline glm::vec3 GetPoint(int iu, int iv) const {
+		return m_grid[2 * (iv * m_division.x + iu)];
+	}
+	inline glm::vec3 GetNormal(int iu, int iv) const {
+		return m_grid[2 * (iv * m_division.x + iu) + 1];
+	}
+};
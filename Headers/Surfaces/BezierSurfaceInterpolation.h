@@ -170,10 +170,12 @@ protected:
 		// Ltrehozunk egy ideiglenes Q hlt
 		PointGrid Q(n_points, std::vector<Vector3d>(m_points));
 
+		// Egyenletes paramterezsnl a kzs Bernstein-tblzatbl olvasunk
+		const BernsteinTable* table_u = parametrizationMethodU == Uniform ? &BernsteinTableCache::Get(n, n_points) : nullptr;
 		MatrixXd A_u(n_points, n_points);
 		for (int k = 0; k < n_points; ++k) {
 			for (int i = 0; i < n_points; ++i) {
-				A_u(k, i) = bernstein(i, n, u_params[k]);
+				A_u(k, i) = table_u != nullptr ? table_u->Weight(k, i) : bernstein(i, n, u_params[k]);
 			}
 		}
 		auto LU_u = A_u.fullPivLu();
@@ -192,10 +194,11 @@ protected:
 		// 3. Interpolci V irnyban (Soronknt a Q hln)
 		PointGrid P(n_points, std::vector<Vector3d>(m_points)); // Vgs kontrollpontok
 
+		const BernsteinTable* table_v = parametrizationMethodV == Uniform ? &BernsteinTableCache::Get(m, m_points) : nullptr;
 		MatrixXd A_v(m_points, m_points);
 		for (int l = 0; l < m_points; ++l) {
 			for (int j = 0; j < m_points; ++j) {
-				A_v(l, j) = bernstein(j, m, v_params[l]);
+				A_v(l, j) = table_v != nullptr ? table_v->Weight(l, j) : bernstein(j, m, v_params[l]);
 			}
 		}
 		auto LU_v = A_v.fullPivLu();
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../include_all.h"
+
+/**
+ * @brief Process-wide cache of the index buffers of sample grids keyed by division.
+ * Sample (iu, iv) of a grid is vertex iv * division.x + iu, every quad is split into two triangles,
+ * so with indexed drawing every sample is processed once by the vertex shader and the shared
+ * samples of the neighbouring triangles can come from the post-transform cache.
+ * The buffers are shared by every surface with the same division, the cache lives on the thread owning the OpenGL context.
+ */
+class GridIndexCache {
+protected:
+	static inline std::map<std::pair<int, int>, GLuint> m_buffers{};
+
+public:
+	/**
+	 * @brief Triangle indices of the grid, row by row.
+	 */
+	static std::vector<GLuint> BuildIndices(glm::ivec2 division);
+	/**
+	 * @brief Returns the element buffer of the division, uploads it on the first call.
+	 */
+	static GLuint Get(glm::ivec2 division);
+	/**
+	 * @brief Deletes every buffer.
+	 */
+	static void Clean();
+
+	inline static GLsizei GetIndexCount(glm::ivec2 division) {
+		return (division.x - 1) * (division.y - 1) * 2 * 3;
+	}
+};
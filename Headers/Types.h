@@ -19,12 +19,34 @@ struct ModelParams {
     int drawMode = GL_TRIANGLES;
 };
 
+// Curve tessellation
+enum class TessellationMode {
+    Shader,         // every vertex evaluates the curve in the vertex shader
+    Cached,         // uniform samples tessellated on the CPU, reused until the curve changes
+    Adaptive        // subdivided on the CPU until every piece is flat within the tolerance
+};
+
+enum class CurveColormap {
+    None,           // single color
+    Curvature,      // curvature of the polyline at the points
+    Torsion         // torsion of the polyline at the points
+};
+
+enum class SurfaceEvaluation {
+    Shader,         // every vertex evaluates the surface in the vertex shader
+    CPU,            // the sample grid is evaluated in two separable stages on the CPU, reused until the surface changes
+    Compute         // the same two stages in a compute pass
+};
+
 struct BezierCurveParams {
     GLuint programID = 0;
     GLuint programSelectedID = 0;
     int smoothness = 10;
     const char* name = "";
     bool show = true;
+    TessellationMode tessellationMode = TessellationMode::Cached;
+    float tolerance = 0.01f;                // flatness tolerance of the adaptive tessellation
+    bool screenSpaceTolerance = false;      // tolerance in pixels instead of world units
 };
 
 struct BSplineParams {
@@ -33,6 +55,12 @@ struct BSplineParams {
     int smoothness = 10;
     const char* name = "";
     bool show = true;
+    TessellationMode tessellationMode = TessellationMode::Shader;
+    float tolerance = 0.01f;                // flatness tolerance of the adaptive tessellation
+    bool screenSpaceTolerance = false;      // tolerance in pixels instead of world units
+    int degree = 3;                         // 1 ... BSplineAlgorithms::MAX_DEGREE
+    bool periodic = false;                  // closed curve with a periodic knot vector
+    bool spanEvaluation = false;            // the shader evaluates cached Bezier spans
 };
 
 struct DiscreteCurveParams {
@@ -40,6 +68,10 @@ struct DiscreteCurveParams {
     GLuint programSelectedID = 0;
     const char* name = "";
     bool show = true;
+    bool levelOfDetail = true;              // draw a simplified level chosen by the screen space error
+    float lodPixelError = 1.f;              // allowed error of the simplified level in pixels
+    int streamHistory = 0;                  // starts streaming with this many points of history if positive
+    CurveColormap colormap = CurveColormap::None;
 };
 
 struct BezierSurfaceParams {
@@ -49,6 +81,8 @@ struct BezierSurfaceParams {
     const char* name = "";
     bool show = true;
     bool wireframe = false;
+    GLuint programGridID = 0;               // Comp_BezierSurfaceGrid, without it the compute evaluation runs on the CPU
+    SurfaceEvaluation evaluation = SurfaceEvaluation::Compute;
 };
 
 // ModelLoader
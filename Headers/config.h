@@ -26,4 +26,12 @@
 #define BEZIERSURFACE2MODELBASE ModelBaseParams{params.programID,params.programSelectedID,params.name,params.show,GL_TRIANGLES}
 
 // for <math.h>
-#define _USE_MATH_DEFINES
\ No newline at end of file
+#define _USE_MATH_DEFINES
+
+// SIMD instruction sets for CPU evaluators
+#if defined(__AVX__)
+#define SIMD_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE
+#endif
\ No newline at end of file
@@ -6,19 +6,30 @@
 // C++ libraries
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <deque>
 #include <filesystem>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <math.h>
 #include <format>
 
+// SIMD intrinsics
+#if defined(SIMD_SSE) || defined(SIMD_AVX)
+#include <immintrin.h>
+#endif
+
 // GLM
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -74,10 +85,25 @@
 #include "Models/ModelLoader.h"
 #include "ModelBase.h"
 #include "Models/Model.h"
+#include "Curves/BernsteinTable.h"
+#include "Curves/BezierEvaluator.h"
+#include "Curves/BezierAlgorithms.h"
+#include "Curves/ArcLengthTable.h"
+#include "Curves/CurveProjector.h"
+#include "Curves/CurveIntersector.h"
+#include "Curves/PolylineSimplifier.h"
+#include "Curves/PointQueue.h"
+#include "Curves/PolylineGeometry.h"
+#include "Curves/BSplineAlgorithms.h"
+#include "Curves/BandedSystem.h"
+#include "Curves/BSplineFitter.h"
+#include "Curves/CurveTessellation.h"
 #include "Curves/BezierCurve.h"
 #include "Curves/BSpline.h"
 #include "Curves/BSplineInterpolation.h"
 #include "Curves/DiscreteCurve.h"
+#include "Surfaces/BezierSurfaceEvaluator.h"
+#include "Surfaces/GridIndexCache.h"
 #include "Surfaces/BezierSurface.h"
 #include "Surfaces/BezierSurfaceInterpolation.h"
 
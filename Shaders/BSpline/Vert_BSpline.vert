@@ -1,7 +1,14 @@
 #version 430 core
 
+// ArcLength
+#define ARC_LENGTH_SSBO 5
+#include "../Modules/ArcLength/ArcLength_uniforms.glsl"
+#include "../Modules/ArcLength/ArcLength.glsl"
+
 #define BSPLINE_CTRL_POINTS_SSBO 1
 #define BSPLINE_KNOTS_SSBO 2
+#define BSPLINE_SPANS_SSBO 6
+#define BSPLINE_SAMPLES_SSBO 7
 #include "../Modules/ObjectTypes/BSpline/BSpline_uniforms.glsl"
 #include "../Modules/ObjectTypes/BSpline/BSpline.glsl"
 
@@ -9,17 +16,43 @@
 #include "../Modules/Camera/Camera_uniforms.glsl"
 #include "../Modules/Camera/Camera.glsl"
 
+// tessellated curve points, used if bSplineData.tessellated is set
+layout(location = 0) in vec4 vs_in_pos;
+
 void main()
 {
+    if (bSplineData.tessellated) {
+        gl_Position = CameraViewProj(vs_in_pos);
+        return;
+    }
+
+    if (bSplineData.bezierSpans && !arcLengthData.enabled) {
+        gl_Position = CameraViewProj(vec4(BSplineSpanSample(
+            gl_VertexID, bSplineData.degree, bSplineData.spanCount, bSplineData.spanDivision
+        ), 1));
+        return;
+    }
+
+    if (bSplineData.cachedSamples && !arcLengthData.enabled) {
+        gl_Position = CameraViewProj(vec4(BSplineSample(BSplineSampleParams(
+            bSplineData.degree, gl_VertexID, bSplineData.ctrlPointCount, bSplineData.periodic
+        )), 1));
+        return;
+    }
+
     int div = max(2, bSplineData.division);
     float tStart = BSplineGetTStart(GetTParams(bSplineData.degree, bSplineData.knotCount));
     float tEnd = BSplineGetTEnd(GetTParams(bSplineData.degree, bSplineData.knotCount));
     float deltaT = (tEnd - tStart) / float(div - 1);
     int index = gl_VertexID;
     float t = tStart + deltaT * float(index);
+    if (arcLengthData.enabled) {
+        t = ArcLengthParam(index);
+    }
 
     gl_Position = CameraViewProj(vec4(BSpline(BSplineParams(
         bSplineData.degree, t,
-        bSplineData.knotCount, bSplineData.ctrlPointCount
+        bSplineData.knotCount, bSplineData.ctrlPointCount,
+        bSplineData.periodic
     )), 1));
 }
\ No newline at end of file
@@ -11,5 +11,7 @@
 
 void main() {
     int index = gl_VertexID;
-    gl_Position = CameraViewProj(BSplineCtrlPoints[index]);
+    // the homogeneous control points of a rational curve project to their Cartesian position
+    vec4 point = BSplineCtrlPoints[index];
+    gl_Position = CameraViewProj(vec4(point.xyz / point.w, 1));
 }
\ No newline at end of file
@@ -1,7 +1,18 @@
 #version 430 core
 
+// BernsteinTable
+#define BERNSTEIN_TABLE_SSBO 3
+#include "../Modules/BernsteinTable/BernsteinTable_uniforms.glsl"
+#include "../Modules/BernsteinTable/BernsteinTable.glsl"
+
+// ArcLength
+#define ARC_LENGTH_SSBO 5
+#include "../Modules/ArcLength/ArcLength_uniforms.glsl"
+#include "../Modules/ArcLength/ArcLength.glsl"
+
 // BezierCurve
 #define BEZIER_CURVE_CTRL_POINTS_SSBO 1
+#define BEZIER_CURVE_COEFFICIENTS_SSBO 6
 #include "../Modules/ObjectTypes/BezierCurve/BezierCurve_uniforms.glsl"
 #include "../Modules/ObjectTypes/BezierCurve/BezierCurve.glsl"
 
@@ -9,13 +20,30 @@
 #include "../Modules/Camera/Camera_uniforms.glsl"
 #include "../Modules/Camera/Camera.glsl"
 
+// tessellated curve points, used if bezierCurveData.tessellated is set
+layout(location = 0) in vec4 vs_in_pos;
+
 void main()
 {
-    int index = gl_VertexID;
-    float deltaT = 1.f / float(bezierCurveData.division - 1);
-    float t = float(index) * deltaT;
+    if (bezierCurveData.tessellated) {
+        gl_Position = CameraViewProj(vs_in_pos);
+        return;
+    }
+
+    if (arcLengthData.enabled) {
+        // u runs over [0, segmentCount], evenly spaced by arc length
+        float u = ArcLengthParam(gl_VertexID);
+        int segment = clamp(int(u), 0, bezierCurveData.segmentCount - 1);
+        gl_Position = CameraViewProj(vec4(BezierCurveHorner(
+            segment, u - float(segment), bezierCurveData.ctrlPointCount
+        ), 1));
+        return;
+    }
+
+    int segment = gl_VertexID / bezierCurveData.division;
+    int index = gl_VertexID % bezierCurveData.division;
 
-	gl_Position = CameraViewProj(vec4(Bezier(
-        BezierParams(t, bezierCurveData.ctrlPointCount)
+	gl_Position = CameraViewProj(vec4(BezierCurveSegmentSample(
+        segment, index, bezierCurveData.ctrlPointCount, bezierCurveData.division
     ), 1));
 }
\ No newline at end of file
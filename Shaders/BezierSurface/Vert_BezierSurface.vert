@@ -4,8 +4,16 @@ out vec3 vs_out_pos;
 out vec3 vs_out_norm;
 out vec2 vs_out_tex;
 
+// BernsteinTable
+#define BERNSTEIN_TABLE_SSBO 3
+#define BERNSTEIN_TABLE_V_SSBO 4
+#include "../Modules/BernsteinTable/BernsteinTable_uniforms.glsl"
+#include "../Modules/BernsteinTable/BernsteinTable.glsl"
+
 // BezierSurface
 #define BEZIER_SURFACE_CTRL_POINTS_SSBO 1
+#define BEZIER_SURFACE_COEFFICIENTS_SSBO 6
+#define BEZIER_SURFACE_GRID_SSBO 7
 #include "../Modules/ObjectTypes/BezierSurface/BezierSurface_uniforms.glsl"
 #include "../Modules/ObjectTypes/BezierSurface/BezierSurface.glsl"
 
@@ -13,7 +21,7 @@ out vec2 vs_out_tex;
 #include "../Modules/Camera/Camera_uniforms.glsl"
 #include "../Modules/Camera/Camera.glsl"
 
-// Triangles
+// Triangles, indexed by GridIndexCache: gl_VertexID is the sample index iv * division.x + iu
 void main()
 {
     int divu = int(bezierSurfaceData.division.x);
@@ -21,29 +29,38 @@ void main()
     int divv = int(bezierSurfaceData.division.y);
     float deltav = 1.f / float(divv - 1);
 
-    int tid = int(floor(gl_VertexID / 3));  // id of the current triangle
-
-    int vr = (bezierSurfaceData.division.x - 1) * 2 * 3;        // verteces in a row
-    int row = int(floor(gl_VertexID / vr));                     // id of the current row
-    int correctID = gl_VertexID - vr * row;                     // collapse to one row
-    int col = int(floor(correctID / 6));                        // id of the current column
-    correctID = correctID - col * 6;                            // collapse to one column
-
-    float u = col * deltau
-            + (tid % 2) * (1 - int(floor(correctID / 5))) * deltau           // +w if the correctID is 3 or 4
-            + (1 - (tid % 2)) * int(floor(correctID / 2)) * deltau;          // +w if the correctID is 2
-    float v = row * deltav
-            + (gl_VertexID % 2) * deltav;                                    // +h if the ID is odd
+    int iv = gl_VertexID / divu;
+    int iu = gl_VertexID - iv * divu;
+    float u = iu * deltau;
+    float v = iv * deltav;
 
     vs_out_tex = vec2(u,v);
 
-    vec4 p = vec4(BezierSurface(
-        BezierSurfaceParams(u, v, bezierSurfaceData.ctrlPointCount)
-    ), 1);
+    vec3 pos;
+    vec3 norm;
+    if (bezierSurfaceData.cachedGrid) {
+        // evaluated once for every sample in two separable stages
+        int index = 2 * (iv * divu + iu);
+        pos = bezierSurfaceGrid[index].xyz;
+        norm = bezierSurfaceGrid[index + 1].xyz;
+    }
+    else {
+        // position and derivatives from the coefficients or from the shared Bernstein tables
+        BezierSurfaceSample s;
+        if (bezierSurfaceData.horner) {
+            s = BezierSurfaceEvaluateHorner(vec2(u, v), bezierSurfaceData.ctrlPointCount);
+        }
+        else {
+            s = BezierSurfaceEvaluateSample(
+                ivec2(iu, iv), bezierSurfaceData.ctrlPointCount, bezierSurfaceData.division
+            );
+        }
+        pos = s.pos;
+        norm = normalize(cross(s.dv, s.du));
+    }
+    vec4 p = vec4(pos, 1);
     gl_Position = CameraViewProj(p);
     vs_out_pos = CameraViewProj(p).xyz;
 
-    vs_out_norm = BezierSurfaceNormal(
-        BezierSurfaceParams(u, v, bezierSurfaceData.ctrlPointCount)
-    );
+    vs_out_norm = norm;
 }
\ No newline at end of file
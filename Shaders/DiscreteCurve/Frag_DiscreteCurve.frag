@@ -3,11 +3,18 @@
 // kimen rtk - a fragment szne
 out vec4 fs_out_col;
 
+// value of the colormap
+in float vs_out_value;
+
 // Color
 #include "../Modules/Color/Color_uniforms.glsl"
 #include "../Modules/Color/Color.glsl"
 
+// Colormap
+#include "../Modules/Colormap/Colormap_uniforms.glsl"
+#include "../Modules/Colormap/Colormap.glsl"
+
 void main()
 {
-	fs_out_col = Color();
+	fs_out_col = colormapData.enabled ? Colormap(vs_out_value) : Color();
 }
\ No newline at end of file
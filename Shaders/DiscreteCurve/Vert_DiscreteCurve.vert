@@ -2,7 +2,19 @@
 
 // DiscreteCurve
 #define DISCRETE_CURVE_CTRL_POINTS_SSBO 1
+#define DISCRETE_CURVE_SCALARS_SSBO 6
 #include "../Modules/ObjectTypes/DiscreteCurve/DiscreteCurve_uniforms.glsl"
+#include "../Modules/ObjectTypes/DiscreteCurve/DiscreteCurve.glsl"
+
+// transform
+#include "../Modules/Transform/Transform_uniforms.glsl"
+#include "../Modules/Transform/Transform.glsl"
+
+// colormap
+#include "../Modules/Colormap/Colormap_uniforms.glsl"
+
+// value of the colormap
+out float vs_out_value;
 
 // camera
 #include "../Modules/Camera/Camera_uniforms.glsl"
@@ -11,5 +23,6 @@
 void main()
 {
     int index = gl_VertexID;
-    gl_Position = CameraViewProj(DiscreteCurveCtrlPoints[index]);
+    gl_Position = CameraViewProj(Transform(DiscreteCurvePoint(index)));
+    vs_out_value = colormapData.enabled ? DiscreteCurveScalars[index] : 0.0;
 }
\ No newline at end of file
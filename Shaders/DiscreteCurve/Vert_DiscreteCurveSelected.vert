@@ -3,6 +3,14 @@
 // DiscreteCurve
 #define DISCRETE_CURVE_CTRL_POINTS_SSBO 1
 #include "../Modules/ObjectTypes/DiscreteCurve/DiscreteCurve_uniforms.glsl"
+#include "../Modules/ObjectTypes/DiscreteCurve/DiscreteCurve.glsl"
+
+// transform
+#include "../Modules/Transform/Transform_uniforms.glsl"
+#include "../Modules/Transform/Transform.glsl"
+
+// value of the colormap, unused for the selection
+out float vs_out_value;
 
 // camera
 #include "../Modules/Camera/Camera_uniforms.glsl"
@@ -11,5 +19,6 @@
 void main()
 {
     int index = gl_VertexID;
-    gl_Position = CameraViewProj(DiscreteCurveCtrlPoints[index]);
+    gl_Position = CameraViewProj(Transform(DiscreteCurvePoint(index)));
+    vs_out_value = 0.0;
 }
\ No newline at end of file
@@ -0,0 +1,6 @@
+/**
+ * @brief Curve parameter of the sample i, the samples are evenly spaced by arc length.
+ */
+float ArcLengthParam(int i) {
+    return arcLengthParams[i];
+}
\ No newline at end of file
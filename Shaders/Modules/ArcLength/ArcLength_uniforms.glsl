@@ -0,0 +1,13 @@
+#ifndef ARC_LENGTH_SSBO
+    #error "ARC_LENGTH_SSBO macro is undefined!"
+#endif
+
+// curve parameters of the samples placed evenly by arc length
+layout(std430, binding = ARC_LENGTH_SSBO) readonly buffer ArcLengthSSBO {
+    float arcLengthParams[];
+};
+
+struct ArcLengthUniforms {
+    bool enabled;	// sample the curve at arcLengthParams instead of uniform parameters
+};
+uniform ArcLengthUniforms arcLengthData;
\ No newline at end of file
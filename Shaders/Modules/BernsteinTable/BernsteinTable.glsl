@@ -0,0 +1,28 @@
+struct BernsteinTableParams {
+    int degree;
+    int division;
+};
+
+/**
+ * @brief B_{n,k}(t_i) of the sample i.
+ */
+float BernsteinTableWeight(BernsteinTableParams params, int i, int k) {
+    return bernsteinTable[i * (params.degree + 1) + k];
+}
+
+/**
+ * @brief Derivative of B_{n,k} at the sample i.
+ */
+float BernsteinTableDerivative(BernsteinTableParams params, int i, int k) {
+    return bernsteinTable[(params.division + i) * (params.degree + 1) + k];
+}
+
+#ifdef BERNSTEIN_TABLE_V_SSBO
+float BernsteinTableVWeight(BernsteinTableParams params, int i, int k) {
+    return bernsteinTableV[i * (params.degree + 1) + k];
+}
+
+float BernsteinTableVDerivative(BernsteinTableParams params, int i, int k) {
+    return bernsteinTableV[(params.division + i) * (params.degree + 1) + k];
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,15 @@
+#ifndef BERNSTEIN_TABLE_SSBO
+    #error "BERNSTEIN_TABLE_SSBO macro is undefined!"
+#endif
+
+// weights B_{n,k}(t_i) at [i * (n + 1) + k], followed by their derivatives
+layout(std430, binding = BERNSTEIN_TABLE_SSBO) readonly buffer BernsteinTableSSBO {
+    float bernsteinTable[];
+};
+
+// optional second table for the v direction of tensor-product surfaces
+#ifdef BERNSTEIN_TABLE_V_SSBO
+layout(std430, binding = BERNSTEIN_TABLE_V_SSBO) readonly buffer BernsteinTableVSSBO {
+    float bernsteinTableV[];
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,6 @@
+struct ColormapUniforms {
+	bool enabled;
+	float minValue;		// value at the start of the colormap
+	float maxValue;		// value at the end of the colormap
+};
+uniform ColormapUniforms colormapData;
\ No newline at end of file
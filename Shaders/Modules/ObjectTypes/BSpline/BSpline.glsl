@@ -5,11 +5,22 @@ const float BSPLINE_EPSILON = 0.00001;
 // A B-Spline fokszma ritkn nagyobb 3-nl vagy 5-nl, a 10 bsgesen elg.
 const int BSPLINE_MAX_DEGREE = 10;
 
+// Degree specialization: a shader that draws a single degree can define BSPLINE_DEGREE before including
+// the module, the loops below then have compile-time bounds and the local arrays shrink to the degree.
+#ifdef BSPLINE_DEGREE
+    #define BSPLINE_LOOP_DEGREE(params) BSPLINE_DEGREE
+    #define BSPLINE_BASIS_SIZE (BSPLINE_DEGREE + 1)
+#else
+    #define BSPLINE_LOOP_DEGREE(params) params.degree
+    #define BSPLINE_BASIS_SIZE (BSPLINE_MAX_DEGREE + 1)
+#endif
+
 struct BSplineParams {
     int degree;
     float t;
     int knotCount;
     int ctrlPointCount;
+    bool periodic;          // closed curve, the control point indices wrap around ctrlPointCount
 };
 
 struct GetTParams {
@@ -17,6 +28,19 @@ struct GetTParams {
     int knotCount;
 };
 
+struct BSplineSampleParams {
+    int degree;
+    int index;              // index of the sample
+    int ctrlPointCount;
+    bool periodic;
+};
+
+struct BSplineSpanParams {
+    int degree;
+    int span;               // index of the Bezier span
+    float s;                // local parameter in [0, 1]
+};
+
 // -------------------------------------------------------------
 // Segdfggvnyek a tartomny lekrshez
 // -------------------------------------------------------------
@@ -28,15 +52,27 @@ float BSplineGetTEnd(GetTParams params) {
     return BSplineKnots[params.knotCount - params.degree - 1];
 }
 
+// Zrt grbnl a paramtert visszatekerjk a [tStart, tEnd) tartomnyba
+float BSplineWrapParam(BSplineParams params) {
+    if (!params.periodic) {
+        return params.t;
+    }
+    float tStart = BSplineKnots[BSPLINE_LOOP_DEGREE(params)];
+    float tEnd = BSplineKnots[params.knotCount - BSPLINE_LOOP_DEGREE(params) - 1];
+    float period = tEnd - tStart;
+    return period > 0.0 ? tStart + mod(params.t - tStart, period) : tStart;
+}
+
 // -------------------------------------------------------------
 // 1. Lps: Knot Span keresse
 // Megkeresi azt az 'i' indexet, amelyre: u_i <= t < u_{i+1}
 // Ez a binris keress sokkal gyorsabb, mint a lineris vgigiterls.
 // -------------------------------------------------------------
 int BSplineFindKnotSpan(BSplineParams params) {
+    params.t = BSplineWrapParam(params);
     // Ha t == tEnd, akkor az utols rvnyes intervallumot adjuk vissza
     // (A "knotCount - degree - 1" az utols csompont indexe a tartomnyban)
-    int n = params.knotCount - params.degree - 1; // Ez felel meg az m-p-nek a szakirodalomban
+    int n = params.knotCount - BSPLINE_LOOP_DEGREE(params) - 1; // Ez felel meg az m-p-nek a szakirodalomban
     
     float tEnd = BSplineKnots[n];
     
@@ -45,7 +81,7 @@ int BSplineFindKnotSpan(BSplineParams params) {
     }
 
     // Binris keress
-    int low = params.degree;
+    int low = BSPLINE_LOOP_DEGREE(params);
     int high = n;
     int mid = (low + high) / 2;
 
@@ -80,13 +116,13 @@ int BSplineFindKnotSpan(BSplineParams params) {
 // Ez a "The NURBS Book" A2.2 algoritmusa.
 // Csak a relevns p+1 darab slyt szmolja ki.
 // -------------------------------------------------------------
-void BSplineEvaluateBasisFunctions(int spanIndex, BSplineParams params, out float N[BSPLINE_MAX_DEGREE + 1]) {
-    float left[BSPLINE_MAX_DEGREE + 1];
-    float right[BSPLINE_MAX_DEGREE + 1];
+void BSplineEvaluateBasisFunctions(int spanIndex, BSplineParams params, out float N[BSPLINE_BASIS_SIZE]) {
+    float left[BSPLINE_BASIS_SIZE];
+    float right[BSPLINE_BASIS_SIZE];
     
     N[0] = 1.0;
 
-    for (int j = 1; j <= params.degree; ++j) {
+    for (int j = 1; j <= BSPLINE_LOOP_DEGREE(params); ++j) {
         left[j] = params.t - BSplineKnots[spanIndex + 1 - j];
         right[j] = BSplineKnots[spanIndex + j] - params.t;
         
@@ -101,35 +137,97 @@ void BSplineEvaluateBasisFunctions(int spanIndex, BSplineParams params, out floa
     }
 }
 
+// -------------------------------------------------------------
+// Rational (NURBS) curves have homogeneous control points (w x, w y, w z, w),
+// the sums run in 4D and the curve point is the projection. Polynomial curves have w = 1.
+// -------------------------------------------------------------
+vec3 BSplineProject(vec4 C) {
+    return abs(C.w) > BSPLINE_EPSILON ? C.xyz / C.w : C.xyz;
+}
+
 // -------------------------------------------------------------
 // Optimalizlt B-Spline kirtkels
 // -------------------------------------------------------------
 vec3 BSpline(BSplineParams params)
 {
     // 1. Megkeressk, melyik csompont-intervallumban vagyunk
+    params.t = BSplineWrapParam(params);
     int spanIndex = BSplineFindKnotSpan(params);
 
     // 2. Kiszmoljuk a p+1 darab nem nulla slyt
-    float weights[BSPLINE_MAX_DEGREE + 1];
+    float weights[BSPLINE_BASIS_SIZE];
     
     // GLSL-ben a tmbket inicializlni kell, vagy biztostani a mretet.
     // Itt felttelezzk, hogy params.degree <= MAX_DEGREE.
     BSplineEvaluateBasisFunctions(spanIndex, params, weights);
 
-    vec3 C = vec3(0.0);
+    vec4 C = vec4(0.0);
 
     // 3. sszegezzk a kontrollpontokat a slyokkal
     // A spanIndex az a csompont index, ahol u_i <= t < u_{i+1}.
     // Az ehhez tartoz kontrollpontok az i-p ... i tartomnyban vannak.
-    for (int i = 0; i <= params.degree; ++i) {
+    for (int i = 0; i <= BSPLINE_LOOP_DEGREE(params); ++i) {
         // A kontrollpont indexe: (spanIndex - degree + i)
-        int cpIndex = spanIndex - params.degree + i;
+        int cpIndex = spanIndex - BSPLINE_LOOP_DEGREE(params) + i;
+        if (params.periodic) {
+            cpIndex = cpIndex % params.ctrlPointCount;
+        }
         
         // Biztonsgi ellenrzs (opcionlis, ha biztosak vagyunk a hatrokban)
         if(cpIndex >= 0 && cpIndex < params.ctrlPointCount) {
-             C += weights[i] * BSplineCtrlPoints[cpIndex].xyz;
+             C += weights[i] * BSplineCtrlPoints[cpIndex];
         }
     }
 
-    return C;
-}
\ No newline at end of file
+    return BSplineProject(C);
+}
+
+#ifdef BSPLINE_SAMPLES_SSBO
+// -------------------------------------------------------------
+// Elre kiszmolt minta: a csompont keress s a bzisfggvnyek helyett
+// egy olvass s egy p+1 tag skalris szorzat.
+// -------------------------------------------------------------
+vec3 BSplineSample(BSplineSampleParams params) {
+    int offset = params.index * (BSPLINE_LOOP_DEGREE(params) + 2);
+    int first = int(BSplineSamples[offset]);
+    vec4 C = vec4(0.0);
+    for (int i = 0; i <= BSPLINE_LOOP_DEGREE(params); ++i) {
+        int cpIndex = first + i;
+        if (params.periodic) {
+            cpIndex = cpIndex % params.ctrlPointCount;
+        }
+        C += BSplineSamples[offset + 1 + i] * BSplineCtrlPoints[cpIndex];
+    }
+    return BSplineProject(C);
+}
+#endif
+
+#ifdef BSPLINE_SPANS_SSBO
+// -------------------------------------------------------------
+// Kirtkels Bezier szakaszonknt: nincs csompont keress s Cox-de Boor rekurzi,
+// Horner-sma a sklzott Bernstein egytthatkbl (lsd BezierCurveHorner).
+// -------------------------------------------------------------
+vec3 BSplineSpan(BSplineSpanParams params) {
+    int n = BSPLINE_LOOP_DEGREE(params);
+    int offset = params.span * (n + 1);
+    float s = params.s;
+    bool reversed = s <= 0.5;
+    float x = reversed ? s / (1.0 - s) : (1.0 - s) / s;
+    vec4 acc = vec4(0.0);
+    for (int k = 0; k <= BSPLINE_LOOP_DEGREE(params); ++k) {
+        acc = acc * x + BSplineSpans[offset + (reversed ? n - k : k)];
+    }
+    float scale = 1.0;
+    for (int k = 0; k < BSPLINE_LOOP_DEGREE(params); ++k) {
+        scale *= reversed ? 1.0 - s : s;
+    }
+    return BSplineProject(acc * scale);
+}
+
+// Sample gl_VertexID of the span by span tessellation: spanDivision samples per span, then the end point
+vec3 BSplineSpanSample(int index, int degree, int spanCount, int spanDivision) {
+    int span = min(index / spanDivision, spanCount - 1);
+    float s = float(index - span * spanDivision) / float(spanDivision);
+    return BSplineSpan(BSplineSpanParams(degree, span, s));
+}
+#endif
\ No newline at end of file
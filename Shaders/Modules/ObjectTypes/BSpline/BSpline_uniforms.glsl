@@ -6,6 +6,7 @@
 #endif
 
 // === Control points SSBO ===
+// homogeneous (w x, w y, w z, w), w is the weight of a rational curve and 1 otherwise
 layout(std430, binding = BSPLINE_CTRL_POINTS_SSBO) buffer BSplineCtrlPointsSSBO {
     vec4 BSplineCtrlPoints[];
 };
@@ -15,10 +16,33 @@ layout(std430, binding = BSPLINE_KNOTS_SSBO) buffer BSplineKnotSSBO {
     float BSplineKnots[];
 };
 
+// === Bezier spans SSBO (optional) ===
+// scaled Bernstein coefficients of the Bezier spans, degree + 1 for every span, written by the CPU
+#ifdef BSPLINE_SPANS_SSBO
+layout(std430, binding = BSPLINE_SPANS_SSBO) readonly buffer BSplineSpansSSBO {
+    vec4 BSplineSpans[];
+};
+#endif
+
+// === Sample weights SSBO (optional) ===
+// degree + 2 floats for every sample of the uniform tessellation: index of the first control point,
+// then the degree + 1 nonzero basis functions, written by the CPU
+#ifdef BSPLINE_SAMPLES_SSBO
+layout(std430, binding = BSPLINE_SAMPLES_SSBO) readonly buffer BSplineSamplesSSBO {
+    float BSplineSamples[];
+};
+#endif
+
 struct BSplineUniforms {
     int degree;             // degree of a single curve
     int knotCount;          // number of knots
     int ctrlPointCount;     // number of control points
     int division;           // total number of divisions for the whole B-Spline object
+    bool tessellated;       // the curve points come from the vertex buffer
+    bool periodic;          // closed curve with a periodic knot vector
+    bool bezierSpans;       // the curve is evaluated span by span from BSplineSpans
+    int spanCount;          // number of Bezier spans
+    int spanDivision;       // number of samples per span, the last point of the curve comes on top
+    bool cachedSamples;     // the knot spans and basis functions of the samples are read from BSplineSamples
 };
 uniform BSplineUniforms bSplineData;
\ No newline at end of file
@@ -15,4 +15,59 @@ vec3 BezierCurve(BezierParams params) {
         val += BernsteinBase(n, k, params.t) * bezierCurveCtrlPoints[k].xyz;
     }
     return val;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Point of the segment-th curve of the buffer at t, every segment has ctrlPointCount points.
+ */
+vec3 BezierCurveSegment(int segment, float t, int ctrlPointCount) {
+    int n = ctrlPointCount - 1;
+    int offset = segment * ctrlPointCount;
+    vec3 val = vec3(0);
+    for (int k = 0; k <= n; ++k) {
+        val += BernsteinBase(n, k, t) * bezierCurveCtrlPoints[offset + k].xyz;
+    }
+    return val;
+}
+
+#ifdef BEZIER_CURVE_COEFFICIENTS_SSBO
+/**
+ * @brief Same as BezierCurveSegment, evaluated with Horner's scheme from the scaled Bernstein coefficients in O(n).
+ * sum_k Q_k t^k (1-t)^(n-k) is evaluated as (1-t)^n * sum_k Q_k s^k with s = t / (1-t) if t <= 0.5,
+ * and as t^n * sum_k Q_k s^(n-k) with s = (1-t) / t otherwise, so s never exceeds 1.
+ */
+vec3 BezierCurveHorner(int segment, float t, int ctrlPointCount) {
+    int n = ctrlPointCount - 1;
+    int offset = segment * ctrlPointCount;
+    bool reversed = t <= 0.5;
+    float s = reversed ? t / (1 - t) : (1 - t) / t;
+    vec3 acc = vec3(0);
+    for (int k = 0; k <= n; ++k) {
+        acc = acc * s + bezierCurveCoefficients[offset + (reversed ? n - k : k)].xyz;
+    }
+    return acc * ipow(reversed ? 1 - t : t, n);
+}
+#endif
+
+#ifdef BERNSTEIN_TABLE_SSBO
+/**
+ * @brief Same as BezierCurveSample for the segment-th curve of the buffer, every segment has ctrlPointCount points.
+ */
+vec3 BezierCurveSegmentSample(int segment, int sampleIndex, int ctrlPointCount, int division) {
+    BernsteinTableParams table = BernsteinTableParams(ctrlPointCount - 1, division);
+    int offset = segment * ctrlPointCount;
+    vec3 val = vec3(0);
+    for (int k = 0; k < ctrlPointCount; ++k) {
+        val += BernsteinTableWeight(table, sampleIndex, k) * bezierCurveCtrlPoints[offset + k].xyz;
+    }
+    return val;
+}
+
+/**
+ * @brief Point of the curve at t = sampleIndex / (division - 1), read from the shared Bernstein table.
+ * Requires the BernsteinTable module with the table of (ctrlPointCount - 1, division).
+ */
+vec3 BezierCurveSample(int sampleIndex, int ctrlPointCount, int division) {
+    return BezierCurveSegmentSample(0, sampleIndex, ctrlPointCount, division);
+}
+#endif
\ No newline at end of file
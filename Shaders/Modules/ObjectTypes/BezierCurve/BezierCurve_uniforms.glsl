@@ -6,8 +6,17 @@ layout(std430, binding = BEZIER_CURVE_CTRL_POINTS_SSBO) buffer BezierCurveCtrlPo
     vec4 bezierCurveCtrlPoints[];
 };
 
+// optional scaled Bernstein coefficients of every segment, written by the CPU
+#ifdef BEZIER_CURVE_COEFFICIENTS_SSBO
+layout(std430, binding = BEZIER_CURVE_COEFFICIENTS_SSBO) readonly buffer BezierCurveCoefficientsBuffer {
+    vec4 bezierCurveCoefficients[];
+};
+#endif
+
 struct BezierCurveUniforms{
 	int ctrlPointCount;
 	int division;
+	bool tessellated;	// the curve points come from the vertex buffer
+	int segmentCount;	// number of curves stored one after the other, ctrlPointCount points each
 };
 uniform BezierCurveUniforms bezierCurveData;
\ No newline at end of file
@@ -91,4 +91,90 @@ vec3 BezierSurfaceNormal(BezierSurfaceParams params) {
     vec3 T_u = BezierSurface_du(params);
     vec3 T_v = BezierSurface_dv(params);
     return normalize(cross(T_v, T_u));
-}
\ No newline at end of file
+}
+
+struct BezierSurfaceSample {
+    vec3 pos;
+    vec3 du;
+    vec3 dv;
+};
+
+#ifdef BEZIER_SURFACE_COEFFICIENTS_SSBO
+/**
+ * @brief Horner sum of count scaled Bernstein coefficients starting at offset, without the (1-t)^n or t^n factor.
+ * With reversed set the sum runs from the last coefficient, see BezierSurfaceEvaluateHorner.
+ */
+vec3 BezierSurfaceHornerRow(int offset, int count, float s, bool reversed) {
+    vec3 acc = vec3(0);
+    for (int k = 0; k < count; ++k) {
+        acc = acc * s + bezierSurfaceCoefficients[offset + (reversed ? count - 1 - k : k)].xyz;
+    }
+    return acc;
+}
+
+/**
+ * @brief Position and partial derivatives at (u, v), in one pass over the scaled Bernstein coefficients.
+ * sum_k Q_k t^k (1-t)^(n-k) is evaluated as (1-t)^n * sum_k Q_k s^k with s = t / (1-t) if t <= 0.5,
+ * and as t^n * sum_k Q_k s^(n-k) with s = (1-t) / t otherwise, so s never exceeds 1.
+ */
+BezierSurfaceSample BezierSurfaceEvaluateHorner(vec2 uv, ivec2 ctrlPointCount) {
+    int rows = ctrlPointCount.x;
+    int cols = ctrlPointCount.y;
+    int nu = cols - 1;
+    int nv = rows - 1;
+
+    bool reversedU = uv.x <= 0.5;
+    bool reversedV = uv.y <= 0.5;
+    float su = reversedU ? uv.x / (1 - uv.x) : (1 - uv.x) / uv.x;
+    float sv = reversedV ? uv.y / (1 - uv.y) : (1 - uv.y) / uv.y;
+    float bu = reversedU ? 1 - uv.x : uv.x;
+    float bv = reversedV ? 1 - uv.y : uv.y;
+
+    int duOffset = rows * cols;
+    int dvOffset = duOffset + rows * nu;
+
+    BezierSurfaceSample s = BezierSurfaceSample(vec3(0), vec3(0), vec3(0));
+    for (int k = 0; k < rows; ++k) {
+        int i = reversedV ? rows - 1 - k : k;
+        s.pos = s.pos * sv + BezierSurfaceHornerRow(i * cols, cols, su, reversedU);
+        s.du = s.du * sv + BezierSurfaceHornerRow(duOffset + i * nu, nu, su, reversedU);
+        // the v derivative has one row less
+        if (i < nv) {
+            s.dv = s.dv * sv + BezierSurfaceHornerRow(dvOffset + i * cols, cols, su, reversedU);
+        }
+    }
+
+    s.pos *= ipow(bu, nu) * ipow(bv, nv);
+    s.du *= ipow(bu, nu - 1) * ipow(bv, nv);
+    s.dv *= ipow(bu, nu) * ipow(bv, nv - 1);
+    return s;
+}
+#endif
+
+#if defined(BERNSTEIN_TABLE_SSBO) && defined(BERNSTEIN_TABLE_V_SSBO)
+/**
+ * @brief Position and partial derivatives at the sample (u index, v index), in one pass over the control points.
+ * Requires the BernsteinTable module, the u table of (ctrlPointCount.y - 1, division.x)
+ * and the v table of (ctrlPointCount.x - 1, division.y).
+ */
+BezierSurfaceSample BezierSurfaceEvaluateSample(ivec2 sampleIndex, ivec2 ctrlPointCount, ivec2 division) {
+    BernsteinTableParams tableU = BernsteinTableParams(ctrlPointCount.y - 1, division.x);
+    BernsteinTableParams tableV = BernsteinTableParams(ctrlPointCount.x - 1, division.y);
+
+    BezierSurfaceSample s = BezierSurfaceSample(vec3(0), vec3(0), vec3(0));
+    for (int i = 0; i < ctrlPointCount.x; ++i) {            // row (v)
+        vec3 p_ = vec3(0.0);
+        vec3 p_u = vec3(0.0);
+        for (int j = 0; j < ctrlPointCount.y; ++j) {        // column (u)
+            vec3 ctrlPoint = bezierSurfaceCtrlPoints[i * ctrlPointCount.y + j].xyz;
+            p_ += BernsteinTableWeight(tableU, sampleIndex.x, j) * ctrlPoint;
+            p_u += BernsteinTableDerivative(tableU, sampleIndex.x, j) * ctrlPoint;
+        }
+        float b_v = BernsteinTableVWeight(tableV, sampleIndex.y, i);
+        s.pos += b_v * p_;
+        s.du += b_v * p_u;
+        s.dv += BernsteinTableVDerivative(tableV, sampleIndex.y, i) * p_;
+    }
+    return s;
+}
+#endif
\ No newline at end of file
@@ -6,8 +6,32 @@ layout(std430, binding = BEZIER_SURFACE_CTRL_POINTS_SSBO) readonly buffer Bezier
     vec4 bezierSurfaceCtrlPoints[];
 };
 
+// optional scaled Bernstein coefficients of the surface and its partial derivatives, written by the CPU
+#ifdef BEZIER_SURFACE_COEFFICIENTS_SSBO
+layout(std430, binding = BEZIER_SURFACE_COEFFICIENTS_SSBO) readonly buffer BezierSurfaceCoefficientsSSBO {
+    vec4 bezierSurfaceCoefficients[];
+};
+#endif
+
+// optional grid of samples evaluated in two separable stages, see Comp_BezierSurfaceGrid and BezierSurfaceEvaluator
+// point (w = 1) and unit normal (w = 0) of the sample (u index, v index) at 2 * (v index * division.x + u index)
+#ifdef BEZIER_SURFACE_GRID_SSBO
+layout(std430, binding = BEZIER_SURFACE_GRID_SSBO) buffer BezierSurfaceGridSSBO {
+    vec4 bezierSurfaceGrid[];
+};
+#endif
+
+// optional first stage of the grid: every row as a curve of u, point and u derivative at 2 * (u index * rows + row)
+#ifdef BEZIER_SURFACE_CURVES_SSBO
+layout(std430, binding = BEZIER_SURFACE_CURVES_SSBO) buffer BezierSurfaceCurvesSSBO {
+    vec4 bezierSurfaceCurves[];
+};
+#endif
+
 struct BezierSurfaceUniforms{
     ivec2 ctrlPointCount;
     ivec2 division;
+    bool horner;    // evaluate with Horner's scheme from the coefficients instead of the Bernstein tables
+    bool cachedGrid;    // read the vertices from bezierSurfaceGrid instead of evaluating them
 };
 uniform BezierSurfaceUniforms bezierSurfaceData;
\ No newline at end of file
@@ -0,0 +1,4 @@
+// i-th point of the curve
+vec4 DiscreteCurvePoint(int i) {
+    return DiscreteCurveCtrlPoints[(discreteCurveData.ringStart + i) % discreteCurveData.ringCapacity];
+}
\ No newline at end of file
@@ -4,4 +4,19 @@
 
 layout(std430, binding = DISCRETE_CURVE_CTRL_POINTS_SSBO) buffer DiscreteCurveCtrlPointsSSBO {
     vec4 DiscreteCurveCtrlPoints[];
-};
\ No newline at end of file
+};
+
+// === Per point scalars SSBO (optional) ===
+// one float for every point, indexed like DiscreteCurvePoint, written by the CPU
+#ifdef DISCRETE_CURVE_SCALARS_SSBO
+layout(std430, binding = DISCRETE_CURVE_SCALARS_SSBO) readonly buffer DiscreteCurveScalarsSSBO {
+    float DiscreteCurveScalars[];
+};
+#endif
+
+// the points are read modulo the capacity from the start, a streamed curve keeps its window in a ring
+struct DiscreteCurveUniforms {
+    int ringStart;          // slot of the first point
+    int ringCapacity;       // number of slots, at least the number of points
+};
+uniform DiscreteCurveUniforms discreteCurveData;
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "../../Headers/include_all.h"
+
+// 5 point Gauss-Legendre nodes and weights on [-1, 1]
+static const float GAUSS_NODES[5] = { 0.f, -0.5384693101f, 0.5384693101f, -0.9061798459f, 0.9061798459f };
+static const float GAUSS_WEIGHTS[5] = { 0.5688888889f, 0.4786286705f, 0.4786286705f, 0.2369268851f, 0.2369268851f };
+
+ArcLengthTable::~ArcLengthTable() {
+	glDeleteBuffers(1, &m_ssboID);
+	m_ssboID = 0;
+}
+
+void ArcLengthTable::Build(const std::vector<std::vector<glm::vec4>>& spans, const std::vector<float>& breaks) {
+	m_hodographs.clear();
+	m_rationalSpans.clear();
+	m_breaks.clear();
+	m_params.clear();
+	m_lengths.clear();
+	m_polyline = false;
+	m_ssboDivision = 0;
+	if (spans.empty() || breaks.size() != spans.size() + 1) {
+		Log::errorToConsole("ArcLengthTable::Build break count does not match the span count");
+		return;
+	}
+
+	m_breaks = breaks;
+	for (const auto& span : spans) {
+		// C'(t) = n * sum (P_{k+1} - P_k) B_{n-1,k}(t)
+		int n = span.size() - 1;
+		std::vector<glm::vec4> hodograph;
+		for (int k = 0; k < n; ++k) {
+			hodograph.push_back(float(n) * (span[k + 1] - span[k]));
+		}
+		if (hodograph.empty()) {
+			hodograph.push_back(glm::vec4(0));
+		}
+		m_hodographs.emplace_back(hodograph);
+		m_rationalSpans.emplace_back(BezierAlgorithms::IsRational(span) ? BezierEvaluator(span) : BezierEvaluator());
+	}
+
+	m_params.push_back(breaks.front());
+	m_lengths.push_back(0.f);
+	for (int i = 0; i < spans.size(); ++i) {
+		for (int j = 1; j <= SUBDIVISIONS; ++j) {
+			float t0 = m_params.back();
+			float t1 = glm::mix(breaks[i], breaks[i + 1], float(j) / float(SUBDIVISIONS));
+			m_lengths.push_back(m_lengths.back() + IntegrateSpeed(i, t0, t1));
+			m_params.push_back(t1);
+		}
+	}
+}
+
+void ArcLengthTable::BuildPolyline(const std::vector<glm::vec4>& points) {
+	m_hodographs.clear();
+	m_rationalSpans.clear();
+	m_breaks.clear();
+	m_params.clear();
+	m_lengths.clear();
+	m_polyline = true;
+	m_ssboDivision = 0;
+	if (points.size() < 2) {
+		return;
+	}
+
+	m_params.resize(points.size());
+	m_lengths.resize(points.size());
+	m_params[0] = 0.f;
+	m_lengths[0] = 0.f;
+	for (size_t i = 1; i < points.size(); ++i) {
+		m_params[i] = float(i);
+		m_lengths[i] = m_lengths[i - 1] + glm::length(glm::vec3(points[i]) - glm::vec3(points[i - 1]));
+	}
+}
+
+glm::vec3 ArcLengthTable::Derivative(int span, float t) const {
+	float width = m_breaks[span + 1] - m_breaks[span];
+	if (width <= 0.f) {
+		return glm::vec3(0);
+	}
+	float local = (t - m_breaks[span]) / width;
+	if (m_rationalSpans[span].GetCtrlPointCount() == 0) {
+		return glm::vec3(m_hodographs[span].Evaluate(local)) / width;
+	}
+	glm::vec3 c, c1;
+	BezierAlgorithms::RationalDerivatives(m_rationalSpans[span].Evaluate(local), m_hodographs[span].Evaluate(local), nullptr, c, c1, nullptr);
+	return c1 / width;
+}
+
+float ArcLengthTable::IntegrateSpeed(int span, float t0, float t1) const {
+	float half = 0.5f * (t1 - t0);
+	float mid = 0.5f * (t1 + t0);
+	float sum = 0.f;
+	for (int i = 0; i < 5; ++i) {
+		sum += GAUSS_WEIGHTS[i] * glm::length(Derivative(span, mid + half * GAUSS_NODES[i]));
+	}
+	return half * sum;
+}
+
+float ArcLengthTable::GetLength(float t) const {
+	if (IsEmpty()) {
+		return 0.f;
+	}
+	t = glm::clamp(t, GetStart(), GetEnd());
+	int j = std::upper_bound(m_params.begin(), m_params.end(), t) - m_params.begin() - 1;
+	j = glm::clamp(j, 0, (int)m_params.size() - 2);
+	if (m_polyline) {
+		return glm::mix(m_lengths[j], m_lengths[j + 1], (t - m_params[j]) / (m_params[j + 1] - m_params[j]));
+	}
+	return m_lengths[j] + IntegrateSpeed(j / SUBDIVISIONS, m_params[j], t);
+}
+
+float ArcLengthTable::GetParam(float s) const {
+	if (IsEmpty()) {
+		return 0.f;
+	}
+	if (s <= 0.f) {
+		return GetStart();
+	}
+	if (s >= GetLength()) {
+		return GetEnd();
+	}
+
+	// interval of the table containing s
+	int j = std::upper_bound(m_lengths.begin(), m_lengths.end(), s) - m_lengths.begin() - 1;
+	j = glm::clamp(j, 0, (int)m_lengths.size() - 2);
+	float lo = m_params[j];
+	float hi = m_params[j + 1];
+	float intervalLength = m_lengths[j + 1] - m_lengths[j];
+	if (intervalLength <= 0.f) {
+		return lo;
+	}
+
+	// initial guess from linear interpolation, then Newton on L(t) - s = 0 with L'(t) = |C'(t)|
+	float t = glm::mix(lo, hi, (s - m_lengths[j]) / intervalLength);
+	if (m_polyline) {
+		return t;		// exact on a straight piece
+	}
+	int span = j / SUBDIVISIONS;
+	for (int i = 0; i < NEWTON_ITERATIONS; ++i) {
+		float error = m_lengths[j] + IntegrateSpeed(span, lo, t) - s;
+		if (std::abs(error) < 1e-6f * GetLength()) {
+			break;
+		}
+		float speed = glm::length(Derivative(span, t));
+		if (speed <= 0.f) {
+			break;
+		}
+		t = glm::clamp(t - error / speed, lo, hi);
+	}
+	return t;
+}
+
+void ArcLengthTable::GetUniformParams(int count, std::vector<float>& out) const {
+	out.resize(glm::max(count, 0));
+	for (int i = 0; i < count; ++i) {
+		float s = count > 1 ? GetLength() * float(i) / float(count - 1) : 0.f;
+		out[i] = GetParam(s);
+	}
+	if (count > 1) {
+		out.back() = GetEnd();
+	}
+}
+
+GLuint ArcLengthTable::GetSSBO(int division) {
+	if (m_ssboID == 0) {
+		glCreateBuffers(1, &m_ssboID);
+	}
+	if (division != m_ssboDivision) {
+		std::vector<float> params;
+		GetUniformParams(division, params);
+		glNamedBufferData(m_ssboID,
+			params.size() * sizeof(float),
+			params.data(),
+			GL_STATIC_DRAW);
+		m_ssboDivision = division;
+	}
+	return m_ssboID;
+}
\ No newline at end of file
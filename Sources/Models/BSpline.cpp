@@ -3,6 +3,9 @@
 BSpline::BSpline(BSplineParams params) : ModelBase(BSPLINE2MODELBASE) {
     m_type = MODEL_TYPE_BSPLINE;
     m_smoothness = params.smoothness;
+    m_tessellationMode = params.tessellationMode;
+    SetTolerance(params.tolerance, params.screenSpaceTolerance);
+    m_spanEvaluation = params.spanEvaluation;
 
     // Alap vezrlpontok
     m_ctrlPoints = {
@@ -18,9 +21,16 @@ BSpline::BSpline(BSplineParams params) : ModelBase(BSPLINE2MODELBASE) {
 
     m_knots = { 0,0,0,0,1,1,1,1,2,2,2,2 };
     m_smoothness = params.smoothness;
+    if (params.degree != m_degree) {
+        SetDegree(params.degree);
+    }
+    if (params.periodic) {
+        SetPeriodic(true);
+    }
 
     SetCtrlPointsSSBO();
     SetKnotsSSBO();
+    SetTessellationVBO();
 }
 
 BSpline::~BSpline() {
@@ -29,8 +39,31 @@ BSpline::~BSpline() {
     m_ctrlPointsSSBOID = 0;
     glDeleteBuffers(1, &m_knotsSSBOID);
     m_knotsSSBOID = 0;
+    glDeleteBuffers(1, &m_spansSSBOID);
+    m_spansSSBOID = 0;
+    glDeleteBuffers(1, &m_samplesSSBOID);
+    m_samplesSSBOID = 0;
 	glDeleteBuffers(1, &m_interpolatedPointsSSBOID);
 	m_interpolatedPointsSSBOID = 0;
+    glDeleteBuffers(1, &m_tessellationVBOID);
+    m_tessellationVBOID = 0;
+    glDeleteVertexArrays(1, &m_tessellationVAOID);
+    m_tessellationVAOID = 0;
+}
+
+std::vector<glm::vec4> BSpline::GetTransformedCtrlPoints() const {
+    std::vector<glm::vec4> newPoints;
+    for (auto& p : m_ctrlPoints) {
+        if (m_applyTransforms)
+            newPoints.push_back(GetTransform() * p);
+        else
+            newPoints.push_back(p);
+    }
+    return newPoints;
+}
+
+std::vector<glm::vec4> BSpline::GetCurveCtrlPoints(const std::vector<glm::vec4>& points) const {
+    return m_periodic ? BSplineAlgorithms::WrapCtrlPoints(points, m_degree) : points;
 }
 
 void BSpline::SetCtrlPointsSSBO() {
@@ -39,20 +72,53 @@ void BSpline::SetCtrlPointsSSBO() {
     WriteCtrlPointsSSBO();
 }
 void BSpline::WriteCtrlPointsSSBO() {
+    int count = GetCtrlPointCount();
+    int begin = glm::clamp(m_ctrlPointsDirtyBegin, 0, count);
+    int end = glm::clamp(m_ctrlPointsDirtyEnd, begin, count);
     m_ctrlPointsDirty = false;
-    std::vector<glm::vec4> newPoints;
-    for (auto& p : m_ctrlPoints) {
-        if (m_applyTransforms)
-            newPoints.push_back(GetTransform() * p);
-        else
-            newPoints.push_back(p);
+    m_ctrlPointsDirtyBegin = 0;
+    m_ctrlPointsDirtyEnd = 0;
+
+    // only the changed control points are transformed again, unless the curve has a different number of them
+    if (m_curveCtrlPoints.size() != GetCurveCtrlPointCount()) {
+        m_curveCtrlPoints = GetCurveCtrlPoints(GetTransformedCtrlPoints());
+        m_spansDirty = true;
+    }
+    else {
+        if (m_spansDirtyBegin < m_spansDirtyEnd) {
+            m_spansDirtyBegin = glm::min(m_spansDirtyBegin, begin);
+            m_spansDirtyEnd = glm::max(m_spansDirtyEnd, end);
+        }
+        else {
+            m_spansDirtyBegin = begin;
+            m_spansDirtyEnd = end;
+        }
+        for (int i = begin; i < end; ++i) {
+            m_curveCtrlPoints[i] = m_applyTransforms ? GetTransform() * m_ctrlPoints[i] : m_ctrlPoints[i];
+        }
+        for (int i = count; i < m_curveCtrlPoints.size(); ++i) {
+            m_curveCtrlPoints[i] = m_curveCtrlPoints[(i - count) % count];
+        }
     }
 
+    // the shader wraps the indices of a closed curve, only the first count points are uploaded
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ctrlPointsSSBOID);
-    glBufferData(GL_SHADER_STORAGE_BUFFER,
-        newPoints.size() * sizeof(glm::vec4),
-        newPoints.data(),
-        GL_STATIC_DRAW);
+    if (count > m_ctrlPointsCapacity) {
+        // grows geometrically, adding points one by one does not reallocate every time
+        m_ctrlPointsCapacity = glm::max(count, 2 * m_ctrlPointsCapacity);
+        glBufferData(GL_SHADER_STORAGE_BUFFER,
+            m_ctrlPointsCapacity * sizeof(glm::vec4),
+            nullptr,
+            GL_DYNAMIC_DRAW);
+        begin = 0;
+        end = count;
+    }
+    if (begin < end) {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER,
+            begin * sizeof(glm::vec4),
+            (end - begin) * sizeof(glm::vec4),
+            m_curveCtrlPoints.data() + begin);
+    }
 }
 
 void BSpline::SetInterpolatedPointsSSBO() {
@@ -85,11 +151,408 @@ void BSpline::SetKnotsSSBO() {
     WriteKnotsSSBO();
 }
 void BSpline::WriteKnotsSSBO() {
+    int count = GetKnotCount();
+    int begin = glm::clamp(m_knotsDirtyBegin, 0, count);
+    int end = glm::clamp(m_knotsDirtyEnd, begin, count);
+    m_knotsDirty = false;
+    m_knotsDirtyBegin = 0;
+    m_knotsDirtyEnd = 0;
+    m_spansDirty = true;
+    m_samplesDirty = true;
+
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_knotsSSBOID);
-    glBufferData(GL_SHADER_STORAGE_BUFFER,
-        m_knots.size() * sizeof(float),
-        m_knots.data(),
-        GL_STATIC_DRAW);
+    if (count > m_knotsCapacity) {
+        m_knotsCapacity = glm::max(count, 2 * m_knotsCapacity);
+        glBufferData(GL_SHADER_STORAGE_BUFFER,
+            m_knotsCapacity * sizeof(float),
+            nullptr,
+            GL_DYNAMIC_DRAW);
+        begin = 0;
+        end = count;
+    }
+    if (begin < end) {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER,
+            begin * sizeof(float),
+            (end - begin) * sizeof(float),
+            m_knots.data() + begin);
+    }
+}
+
+void BSpline::WriteSpansSSBO() {
+    m_spansDirty = false;
+    m_spansDirtyBegin = 0;
+    m_spansDirtyEnd = 0;
+    m_spanCount = 0;
+    m_spanKnots.clear();
+    if (!BSplineAlgorithms::IsValid(m_degree, m_knots, m_curveCtrlPoints)) {
+        return;
+    }
+    // the same spans as BSplineAlgorithms::DecomposeToBezier, their knot spans are kept for the partial updates
+    std::vector<glm::vec4> coefficients;
+    int n = m_curveCtrlPoints.size() - 1;
+    for (int i = m_degree; i <= n; ++i) {
+        if (m_knots[i + 1] - m_knots[i] <= BSplineAlgorithms::EPSILON) {
+            continue;
+        }
+        std::vector<glm::vec4> scaled = BezierAlgorithms::ScaledBernstein(BSplineAlgorithms::SpanToBezier(m_degree, m_knots, m_curveCtrlPoints, i));
+        coefficients.insert(coefficients.end(), scaled.begin(), scaled.end());
+        m_spanKnots.push_back(i);
+        ++m_spanCount;
+    }
+
+    if (m_spansSSBOID == 0) {
+        glCreateBuffers(1, &m_spansSSBOID);
+    }
+    if (coefficients.size() > m_spansCapacity) {
+        m_spansCapacity = coefficients.size();
+        glNamedBufferData(m_spansSSBOID,
+            coefficients.size() * sizeof(glm::vec4),
+            coefficients.data(),
+            GL_DYNAMIC_DRAW);
+    }
+    else {
+        glNamedBufferSubData(m_spansSSBOID,
+            0,
+            coefficients.size() * sizeof(glm::vec4),
+            coefficients.data());
+    }
+}
+
+void BSpline::UpdateSpansSSBO() {
+    int count = GetCtrlPointCount();
+    int begin = glm::clamp(m_spansDirtyBegin, 0, count);
+    int end = glm::clamp(m_spansDirtyEnd, begin, count);
+    m_spansDirtyBegin = 0;
+    m_spansDirtyEnd = 0;
+    if (begin == end) {
+        return;
+    }
+    RewriteSpans(begin, end);
+
+    // the repeated control points at the end of a closed curve
+    int wrappedBegin = m_curveCtrlPoints.size();
+    int wrappedEnd = 0;
+    for (int i = count; i < m_curveCtrlPoints.size(); ++i) {
+        int k = (i - count) % count;
+        if (k >= begin && k < end) {
+            wrappedBegin = glm::min(wrappedBegin, i);
+            wrappedEnd = i + 1;
+        }
+    }
+    if (wrappedBegin < wrappedEnd) {
+        RewriteSpans(wrappedBegin, wrappedEnd);
+    }
+}
+void BSpline::RewriteSpans(int first, int last) {
+    // curve control points [first, last) are nonzero on the knot spans first ... last - 1 + p
+    int p = m_degree;
+    auto from = std::lower_bound(m_spanKnots.begin(), m_spanKnots.end(), first);
+    auto to = std::lower_bound(from, m_spanKnots.end(), last + p);
+    if (from == to) {
+        return;
+    }
+    std::vector<glm::vec4> coefficients;
+    coefficients.reserve((to - from) * (p + 1));
+    for (auto it = from; it != to; ++it) {
+        std::vector<glm::vec4> scaled = BezierAlgorithms::ScaledBernstein(BSplineAlgorithms::SpanToBezier(p, m_knots, m_curveCtrlPoints, *it));
+        coefficients.insert(coefficients.end(), scaled.begin(), scaled.end());
+    }
+    glNamedBufferSubData(m_spansSSBOID,
+        (from - m_spanKnots.begin()) * (p + 1) * sizeof(glm::vec4),
+        coefficients.size() * sizeof(glm::vec4),
+        coefficients.data());
+}
+
+void BSpline::WriteSamplesSSBO() {
+    m_samplesDirty = false;
+    m_samplesDivision = 0;
+    int p = m_degree;
+    int count = GetCurveCtrlPointCount();
+    if (p < 1 || count < p + 1 || m_knots.size() != count + p + 1) {
+        return;
+    }
+
+    // the same parameters as the shader, only the control points move between rebuilds
+    int division = glm::max(2, GetSmoothness());
+    int stride = p + 2;
+    float tStart = m_knots[p];
+    float tEnd = m_knots[count];
+    float deltaT = (tEnd - tStart) / float(division - 1);
+    std::vector<float> samples(division * stride);
+    for (int i = 0; i < division; ++i) {
+        float t = tStart + deltaT * float(i);
+        int span = BSplineAlgorithms::FindSpan(count - 1, p, t, m_knots);
+        float* sample = samples.data() + i * stride;
+        sample[0] = float(span - p);
+        BSplineAlgorithms::BasisFuns(span, t, p, m_knots, sample + 1);
+    }
+
+    if (m_samplesSSBOID == 0) {
+        glCreateBuffers(1, &m_samplesSSBOID);
+    }
+    if (samples.size() > m_samplesCapacity) {
+        m_samplesCapacity = samples.size();
+        glNamedBufferData(m_samplesSSBOID,
+            samples.size() * sizeof(float),
+            samples.data(),
+            GL_DYNAMIC_DRAW);
+    }
+    else {
+        glNamedBufferSubData(m_samplesSSBOID,
+            0,
+            samples.size() * sizeof(float),
+            samples.data());
+    }
+    m_samplesDivision = division;
+}
+
+void BSpline::SetTessellationVBO() {
+    glCreateBuffers(1, &m_tessellationVBOID);
+    glCreateVertexArrays(1, &m_tessellationVAOID);
+    glVertexArrayVertexBuffer(m_tessellationVAOID, 0, m_tessellationVBOID, 0, sizeof(glm::vec4));
+    glEnableVertexArrayAttrib(m_tessellationVAOID, 0);
+    glVertexArrayAttribBinding(m_tessellationVAOID, 0, 0);
+    glVertexArrayAttribFormat(m_tessellationVAOID, 0, 4, GL_FLOAT, GL_FALSE, 0);
+}
+void BSpline::WriteTessellationVBO(RenderParams* p) {
+    std::vector<glm::vec4> points;
+    if (GetTessellationMode() == TessellationMode::Adaptive) {
+        CurveTessellation::AdaptiveParams adaptive;
+        adaptive.tolerance = m_tolerance;
+        adaptive.screenSpace = m_screenSpaceTolerance;
+        adaptive.viewProj = p->viewProj;
+        adaptive.viewport = p->windowSize;
+        CurveTessellation::AdaptiveBSpline(m_degree, m_knots, m_curveCtrlPoints, adaptive, points);
+        m_tessellationViewProj = p->viewProj;
+        m_tessellationViewport = p->windowSize;
+    }
+    else if (GetArcLengthSampling()) {
+        std::vector<float> params;
+        GetRenderArcLengthTable().GetUniformParams(GetSmoothness(), params);
+        for (float t : params) {
+            points.push_back(BezierAlgorithms::Dehomogenize(BSplineAlgorithms::CurvePoint(m_degree, m_knots, m_curveCtrlPoints, t)));
+        }
+    }
+    else {
+        CurveTessellation::TessellateBSpline(m_degree, m_knots, m_curveCtrlPoints, GetSmoothness(), points);
+    }
+    if (points.size() > m_tessellationCapacity) {
+        m_tessellationCapacity = points.size();
+        glNamedBufferData(m_tessellationVBOID,
+            points.size() * sizeof(glm::vec4),
+            points.data(),
+            GL_DYNAMIC_DRAW);
+    }
+    else {
+        glNamedBufferSubData(m_tessellationVBOID,
+            0,
+            points.size() * sizeof(glm::vec4),
+            points.data());
+    }
+    m_tessellationVertexCount = points.size();
+    m_tessellationDirty = false;
+    m_tessellationDirtyBegin = 0;
+    m_tessellationDirtyEnd = 0;
+}
+void BSpline::UpdateTessellationVBO() {
+    int count = GetCtrlPointCount();
+    int begin = glm::clamp(m_tessellationDirtyBegin, 0, count);
+    int end = glm::clamp(m_tessellationDirtyEnd, begin, count);
+    m_tessellationDirtyBegin = 0;
+    m_tessellationDirtyEnd = 0;
+    if (begin == end) {
+        return;
+    }
+    RetessellateSpans(begin, end);
+
+    // the repeated control points at the end of a closed curve
+    int wrappedBegin = m_curveCtrlPoints.size();
+    int wrappedEnd = 0;
+    for (int i = count; i < m_curveCtrlPoints.size(); ++i) {
+        int k = (i - count) % count;
+        if (k >= begin && k < end) {
+            wrappedBegin = glm::min(wrappedBegin, i);
+            wrappedEnd = i + 1;
+        }
+    }
+    if (wrappedBegin < wrappedEnd) {
+        RetessellateSpans(wrappedBegin, wrappedEnd);
+    }
+}
+void BSpline::RetessellateSpans(int first, int last) {
+    std::vector<glm::vec4> points;
+    int offset = 0;
+    CurveTessellation::TessellateBSplineSpans(m_degree, m_knots, m_curveCtrlPoints, GetSmoothness(), first, last, points, offset);
+    if (points.empty()) {
+        return;
+    }
+    glNamedBufferSubData(m_tessellationVBOID,
+        offset * sizeof(glm::vec4),
+        points.size() * sizeof(glm::vec4),
+        points.data());
+}
+
+void BSpline::SetDegree(int degree) {
+    if (degree < 1 || degree > BSplineAlgorithms::MAX_DEGREE) {
+        Log::errorToConsole("BSpline::SetDegree degree must be between 1 and ", BSplineAlgorithms::MAX_DEGREE);
+        return;
+    }
+    if (degree >= GetCtrlPointCount()) {
+        Log::errorToConsole("BSpline::SetDegree needs at least ", degree + 1, " control points for degree ", degree);
+        return;
+    }
+    float start, end;
+    GetDomain(start, end);
+    m_degree = degree;
+    ResetKnots(start, end);
+}
+void BSpline::SetPeriodic(bool periodic) {
+    if (periodic == m_periodic) {
+        return;
+    }
+    if (GetCtrlPointCount() < m_degree + 1) {
+        Log::errorToConsole("BSpline::SetPeriodic needs at least ", m_degree + 1, " control points");
+        return;
+    }
+    float start, end;
+    GetDomain(start, end);
+    m_periodic = periodic;
+    ResetKnots(start, end);
+}
+void BSpline::InsertKnot(float u, int times) {
+    RefineKnots(std::vector<float>(glm::max(times, 0), u));
+}
+void BSpline::RefineKnots(std::vector<float> knots) {
+    if (m_periodic) {
+        Log::errorToConsole("BSpline::RefineKnots is not supported on closed curves");
+        return;
+    }
+    if (!BSplineAlgorithms::IsValid(m_degree, m_knots, m_ctrlPoints)) {
+        Log::errorToConsole("BSpline::RefineKnots knot vector does not match the control points");
+        return;
+    }
+    float start, end;
+    GetDomain(start, end);
+    std::sort(knots.begin(), knots.end());
+    for (float knot : knots) {
+        int multiplicity = BSplineAlgorithms::KnotMultiplicity(m_knots, knot) + std::count(knots.begin(), knots.end(), knot);
+        if (knot <= start || knot >= end || multiplicity > m_degree) {
+            Log::errorToConsole("BSpline::RefineKnots knot ", knot, " is not inside the domain or its multiplicity would exceed the degree");
+            return;
+        }
+    }
+    std::vector<float> U = m_knots;
+    std::vector<glm::vec4> P = m_ctrlPoints;
+    BSplineAlgorithms::RefineKnotVector(m_degree, U, P, knots);
+    SetCtrlPoints(P);
+    SetKnots(U);
+}
+void BSpline::RefineUniformly() {
+    float start, end;
+    GetDomain(start, end);
+    std::vector<float> midpoints;
+    for (int i = m_degree; i + 1 < m_knots.size() && m_knots[i] < end; ++i) {
+        if (m_knots[i + 1] - m_knots[i] > BSplineAlgorithms::EPSILON) {
+            midpoints.push_back(0.5f * (m_knots[i] + m_knots[i + 1]));
+        }
+    }
+    RefineKnots(midpoints);
+}
+int BSpline::RemoveKnots(float tolerance) {
+    if (m_periodic) {
+        Log::errorToConsole("BSpline::RemoveKnots is not supported on closed curves");
+        return 0;
+    }
+    // the error is measured between homogeneous points, on a rational curve it is scaled down so that
+    // the Cartesian deviation stays below tolerance (The NURBS Book, eq. 5.30)
+    if (IsRational()) {
+        float minWeight = std::numeric_limits<float>::max();
+        float maxLength = 0.f;
+        for (int i = 0; i < GetCtrlPointCount(); ++i) {
+            minWeight = glm::min(minWeight, GetCtrlPointWeight(i));
+            maxLength = glm::max(maxLength, glm::length(GetCtrlPointPosition(i)));
+        }
+        tolerance *= minWeight / (1.f + maxLength);
+    }
+    std::vector<float> U = m_knots;
+    std::vector<glm::vec4> P = m_ctrlPoints;
+    int removed = BSplineAlgorithms::RemoveKnots(m_degree, U, P, tolerance);
+    if (removed > 0) {
+        SetCtrlPoints(P);
+        SetKnots(U);
+    }
+    return removed;
+}
+void BSpline::GetDomain(float& start, float& end) const {
+    start = 0.f;
+    end = 1.f;
+    if (BSplineAlgorithms::IsValid(m_degree, m_knots, GetCurveCtrlPoints(m_ctrlPoints))) {
+        start = m_knots[m_degree];
+        end = m_knots[GetCurveCtrlPointCount()];
+    }
+}
+void BSpline::ResetKnots(float start, float end) {
+    if (m_periodic) {
+        SetKnots(BSplineAlgorithms::PeriodicUniformKnots(GetCtrlPointCount(), m_degree, start, end));
+    }
+    else {
+        SetKnots(BSplineAlgorithms::ClampedUniformKnots(GetCtrlPointCount(), m_degree, start, end));
+    }
+    m_tessellationDirty = true;
+}
+
+void BSpline::GetBezierSpans(std::vector<std::vector<glm::vec4>>& spans, std::vector<float>& breaks, bool world) const {
+    spans.clear();
+    breaks.clear();
+    std::vector<glm::vec4> ctrlPoints = GetCurveCtrlPoints(world ? GetTransformedCtrlPoints() : m_ctrlPoints);
+    if (!BSplineAlgorithms::IsValid(m_degree, m_knots, ctrlPoints)) {
+        Log::errorToConsole("BSpline::GetBezierSpans knot vector does not match the control points");
+        return;
+    }
+    spans = BSplineAlgorithms::DecomposeToBezier(m_degree, m_knots, ctrlPoints);
+    // the Bezier spans belong to the distinct knots of the domain
+    for (int i = m_degree; i <= GetCurveCtrlPointCount(); ++i) {
+        if (breaks.empty() || m_knots[i] - breaks.back() > BSplineAlgorithms::EPSILON) {
+            breaks.push_back(m_knots[i]);
+        }
+    }
+}
+ArcLengthTable& BSpline::GetArcLengthTable() {
+    if (m_arcLengthDirty) {
+        std::vector<std::vector<glm::vec4>> spans;
+        std::vector<float> breaks;
+        GetBezierSpans(spans, breaks);
+        m_arcLengthTable.Build(spans, breaks);
+        m_arcLengthDirty = false;
+    }
+    return m_arcLengthTable;
+}
+ArcLengthTable& BSpline::GetRenderArcLengthTable() {
+    if (m_renderArcLengthDirty) {
+        std::vector<std::vector<glm::vec4>> spans;
+        std::vector<float> breaks;
+        GetBezierSpans(spans, breaks, true);
+        m_renderArcLengthTable.Build(spans, breaks);
+        m_renderArcLengthDirty = false;
+    }
+    return m_renderArcLengthTable;
+}
+CurveProjector BSpline::GetProjector() const {
+    std::vector<std::vector<glm::vec4>> spans;
+    std::vector<float> breaks;
+    GetBezierSpans(spans, breaks);
+    return CurveProjector(spans, breaks);
+}
+std::vector<CurveProjection> BSpline::Project(const std::vector<glm::vec3>& points, int threadCount) const {
+    return GetProjector().Project(points, threadCount);
+}
+glm::vec4 BSpline::GetPointAtLength(float s) {
+    std::vector<glm::vec4> ctrlPoints = GetCurveCtrlPoints(m_ctrlPoints);
+    if (!BSplineAlgorithms::IsValid(m_degree, m_knots, ctrlPoints)) {
+        Log::errorToConsole("BSpline::GetPointAtLength knot vector does not match the control points");
+        return glm::vec4(0);
+    }
+    return BezierAlgorithms::Dehomogenize(BSplineAlgorithms::CurvePoint(m_degree, m_knots, ctrlPoints, GetArcLengthTable().GetParam(s)));
 }
 
 void BSpline::Render(RenderParams* p) {
@@ -124,12 +587,53 @@ void BSpline::Render(RenderParams* p) {
         transformsReset = true;
     }
 
-    if (transformsReset || m_ctrlPointsDirty) {
-        WriteCtrlPointsSSBO();
+    if (transformsReset) {
+        m_ctrlPointsDirty = true;
+        m_ctrlPointsDirtyBegin = 0;
+        m_ctrlPointsDirtyEnd = GetCtrlPointCount();
         WriteInterpolatedPointsSSBO();
+        m_tessellationDirty = true;
+        m_renderArcLengthDirty = true;
+    }
+    bool resized = m_curveCtrlPoints.size() != GetCurveCtrlPointCount();
+    if (m_ctrlPointsDirty || resized) {
+        // B-Splines have local support, moved control points change only their own spans
+        if (resized) {
+            m_tessellationDirty = true;
+            m_samplesDirty = true;
+        }
+        else if (m_tessellationDirtyBegin < m_tessellationDirtyEnd) {
+            m_tessellationDirtyBegin = glm::min(m_tessellationDirtyBegin, m_ctrlPointsDirtyBegin);
+            m_tessellationDirtyEnd = glm::max(m_tessellationDirtyEnd, m_ctrlPointsDirtyEnd);
+        }
+        else {
+            m_tessellationDirtyBegin = m_ctrlPointsDirtyBegin;
+            m_tessellationDirtyEnd = m_ctrlPointsDirtyEnd;
+        }
+        WriteCtrlPointsSSBO();
     }
     if (m_knotsDirty) {
         WriteKnotsSSBO();
+        m_tessellationDirty = true;
+    }
+
+    // -- Tessellate the curve if needed --
+    bool cached = GetTessellationMode() != TessellationMode::Shader;
+    if (GetTessellationMode() == TessellationMode::Adaptive && m_screenSpaceTolerance
+        && (p->viewProj != m_tessellationViewProj || p->windowSize != m_tessellationViewport)) {
+        m_tessellationDirty = true;
+    }
+    if (cached && !m_tessellationDirty && m_tessellationDirtyBegin < m_tessellationDirtyEnd) {
+        // only the uniform tessellation keeps the points of the unchanged spans
+        if (GetTessellationMode() == TessellationMode::Adaptive || GetArcLengthSampling() || m_tessellationVertexCount != GetSmoothness()) {
+            m_tessellationDirty = true;
+        }
+        else {
+            UpdateTessellationVBO();
+        }
+    }
+    if (cached && m_tessellationDirty) {
+        WriteTessellationVBO(p);
     }
 
     // -- Set render options --
@@ -143,12 +647,47 @@ void BSpline::Render(RenderParams* p) {
 
     // -- Set shader input data --
     // BSpline module
+    bool arcLength = !cached && GetArcLengthSampling();
+    bool spans = !cached && !arcLength && m_spanEvaluation;
+    if (spans && m_spansDirty) {
+        WriteSpansSSBO();
+    }
+    else if (spans && m_spansDirtyBegin < m_spansDirtyEnd) {
+        // only the spans of the moved control points are extracted again
+        UpdateSpansSSBO();
+    }
+    spans = spans && m_spanCount > 0;
+    // samples are spread evenly over the spans, division points in total at least
+    int spanDivision = spans ? glm::max(1, (GetSmoothness() - 1 + m_spanCount - 1) / m_spanCount) : 1;
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, GetCtrlPointsSSBO());
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, GetKnotsSSBO());
+    if (spans) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, m_spansSSBOID);
+    }
+    // the knot spans and basis functions of the samples only change with the knots and the division
+    bool samples = !cached && !arcLength && !spans;
+    if (samples && (m_samplesDirty || m_samplesDivision != glm::max(2, GetSmoothness()))) {
+        WriteSamplesSSBO();
+    }
+    samples = samples && m_samplesDivision > 0;
+    if (samples) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, m_samplesSSBOID);
+    }
+    glUniform1i(ul(progID, "bSplineData.cachedSamples"), samples);
+    glUniform1i(ul(progID, "bSplineData.bezierSpans"), spans);
+    glUniform1i(ul(progID, "bSplineData.spanCount"), m_spanCount);
+    glUniform1i(ul(progID, "bSplineData.spanDivision"), spanDivision);
     glUniform1i(ul(progID, "bSplineData.ctrlPointCount"), GetCtrlPointCount());
     glUniform1i(ul(progID, "bSplineData.knotCount"), GetKnotCount());
     glUniform1i(ul(progID, "bSplineData.degree"), m_degree);
     glUniform1i(ul(progID, "bSplineData.division"), m_smoothness);
+    glUniform1i(ul(progID, "bSplineData.tessellated"), cached);
+    glUniform1i(ul(progID, "bSplineData.periodic"), m_periodic);
+    // Arc length module
+    glUniform1i(ul(progID, "arcLengthData.enabled"), arcLength);
+    if (arcLength) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, GetRenderArcLengthTable().GetSSBO(GetSmoothness()));
+    }
     // Camera module
     glUniform3fv(ul(progID, "cameraData.eye"), 1, glm::value_ptr(p->cameraPos));
     glUniformMatrix4fv(ul(progID, "cameraData.viewProj"), 1, GL_FALSE, glm::value_ptr(p->viewProj));
@@ -156,7 +695,17 @@ void BSpline::Render(RenderParams* p) {
     glUniform3fv(ul(progID, "colorData.color"), 1, glm::value_ptr(GetColor()));
 
     // -- Draw call --
-    glDrawArrays(GetDrawMode(), 0, GetSmoothness());
+    if (cached) {
+        glBindVertexArray(m_tessellationVAOID);
+        glDrawArrays(GetDrawMode(), 0, m_tessellationVertexCount);
+        glBindVertexArray(0);
+    }
+    else if (spans) {
+        glDrawArrays(GetDrawMode(), 0, m_spanCount * spanDivision + 1);
+    }
+    else {
+        glDrawArrays(GetDrawMode(), 0, GetSmoothness());
+    }
 
     // -- Restore initial OGL state --
     glLineWidth(lineWidth);
@@ -199,7 +748,7 @@ void BSpline::RenderSelection(RenderParams* p) {
     glUniform3fv(ul(progID, "colorData.color"), 1, glm::value_ptr(p->selectionColor));
 
     // -- Draw call --
-    glDrawArrays(GL_POINTS, 0, GetCtrlPoints().size());
+    glDrawArrays(GL_POINTS, 0, GetCtrlPointCount());
 
     // -- Restore initial OGL state --
     glPointSize(pointSize);
@@ -217,17 +766,60 @@ void BSpline::RenderGUI(std::vector<ModelBase*>* models) {
         b->SetSmoothness(smoothness);
     }
 
+    // Degree
+    int degree = b->GetDegree();
+    if (ImGui::SliderInt("Degree", &degree, 1, BSplineAlgorithms::MAX_DEGREE)) {
+        b->SetDegree(degree);
+    }
+    bool periodic = b->GetPeriodic();
+    if (ImGui::Checkbox("Closed (periodic)", &periodic)) {
+        b->SetPeriodic(periodic);
+    }
+
+    // tessellation
+    int mode = (int)b->GetTessellationMode();
+    if (ImGui::Combo("Tessellation", &mode, "Shader\0Cached\0Adaptive\0")) {
+        b->SetTessellationMode((TessellationMode)mode);
+    }
+    if (b->GetTessellationMode() != TessellationMode::Adaptive) {
+        bool arcLength = b->GetArcLengthSampling();
+        if (ImGui::Checkbox("Even spacing by arc length", &arcLength)) {
+            b->SetArcLengthSampling(arcLength);
+        }
+    }
+    if (b->GetTessellationMode() == TessellationMode::Shader && !b->GetArcLengthSampling()) {
+        bool spans = b->GetSpanEvaluation();
+        if (ImGui::Checkbox("Evaluate Bezier spans", &spans)) {
+            b->SetSpanEvaluation(spans);
+        }
+    }
+    if (b->GetTessellationMode() == TessellationMode::Adaptive) {
+        float tolerance = b->GetTolerance();
+        bool screenSpace = b->GetScreenSpaceTolerance();
+        bool changed = ImGui::DragFloat("Tolerance", &tolerance, 0.001f, 0.0001f, 10.f, "%.4f");
+        changed |= ImGui::Checkbox("Tolerance in pixels", &screenSpace);
+        if (changed) {
+            b->SetTolerance(tolerance, screenSpace);
+        }
+    }
+
     // ctrl points
     ImGui::Spacing();
     if (ImGui::CollapsingHeader("Control points")) {
         int ctrlPointCount = 0;
         for (auto p : b->GetCtrlPoints()) {
-            glm::vec3 point = p;
+            glm::vec3 point = BezierAlgorithms::Dehomogenize(p);
             std::stringstream label;
             label << "Ctrl point " << ctrlPointCount;
             if (ImGui::InputFloat3(label.str().c_str(), &point.x)) {
                 b->SetCtrlPoint(ctrlPointCount, point);
             }
+            float weight = p.w;
+            label.str("");
+            label << "Weight #" << ctrlPointCount;
+            if (ImGui::DragFloat(label.str().c_str(), &weight, 0.01f, 0.01f, 100.f, "%.3f")) {
+                b->SetCtrlPointWeight(ctrlPointCount, weight);
+            }
             ImGui::SameLine();
             label.str("");
             label << "Delete #" << ctrlPointCount;
@@ -268,6 +860,19 @@ void BSpline::RenderGUI(std::vector<ModelBase*>* models) {
         if (ImGui::Button("Add")) {
             b->AddKnot(m_newKnot);
         }
+        ImGui::SameLine();
+        if (ImGui::Button("Insert (keep shape)")) {
+            b->InsertKnot(m_newKnot);
+        }
+        if (ImGui::Button("Refine uniformly")) {
+            b->RefineUniformly();
+        }
+        ImGui::DragFloat("Removal tolerance", &m_knotRemovalTolerance, 0.0001f, 0.f, 10.f, "%.4f");
+        ImGui::SameLine();
+        if (ImGui::Button("Remove knots")) {
+            m_removedKnotCount = b->RemoveKnots(m_knotRemovalTolerance);
+        }
+        ImGui::Text("Removed knots: %d", m_removedKnotCount);
     }
 
     // interpolation points
@@ -294,6 +899,14 @@ void BSpline::RenderGUI(std::vector<ModelBase*>* models) {
         b->SetColor(m_curveColor);
     }
 
+    // intersections
+    ImGui::DragFloat("Intersection tolerance", &m_intersectionTolerance, 0.0001f, 0.00001f, 1.f, "%.5f");
+    if (ImGui::Button("Intersect with other curves")) {
+        m_intersectionCount = CurveIntersector::IntersectWithScene(this, *models, m_intersectionTolerance);
+    }
+    ImGui::SameLine();
+    ImGui::Text("Intersections: %d", m_intersectionCount);
+
     ImGui::Spacing();
     ImGui::Separator();
     ImGui::Spacing();
@@ -0,0 +1,124 @@
+#include "../../Headers/include_all.h"
+
+BSplineFitter::BSplineFitter(int ctrlPointCount, int degree, float start, float end) {
+	if (degree < 1 || ctrlPointCount < degree + 1 || end <= start) {
+		Log::errorToConsole("BSplineFitter::BSplineFitter needs at least degree + 1 control points and a nonempty domain");
+		return;
+	}
+	m_degree = degree;
+	m_knots = BSplineAlgorithms::ClampedUniformKnots(ctrlPointCount, degree, start, end);
+	m_normal = BandedSystem::SymmetricBandedMatrix(ctrlPointCount, degree);
+	m_rhs.assign(ctrlPointCount, glm::dvec4(0));
+	m_basis.resize(degree + 1);
+	m_ders.resize(2 * (degree + 1));
+	m_dersScratch.resize(BSplineAlgorithms::DersScratchSize(degree));
+}
+
+float BSplineFitter::CorrectParam(const glm::vec4& point, float t) {
+	float start = m_knots[m_degree];
+	float end = m_knots[m_normal.n];
+	int n = m_normal.n - 1;
+	for (const auto& ctrlPoints : m_corrections) {
+		// like AddPoint, the basis is evaluated into the members without allocating
+		int span = BSplineAlgorithms::FindSpan(n, m_degree, t, m_knots);
+		BSplineAlgorithms::DersBasisFuns(span, t, m_degree, 1, m_knots, m_ders.data(), m_dersScratch.data());
+		int first = span - m_degree;
+		glm::vec3 c(0);
+		glm::vec3 d(0);
+		for (int k = 0; k <= m_degree; ++k) {
+			c += m_ders[k] * glm::vec3(ctrlPoints[first + k]);
+			d += m_ders[m_degree + 1 + k] * glm::vec3(ctrlPoints[first + k]);
+		}
+		// move the parameter to the foot point on the tangent
+		float speed2 = glm::dot(d, d);
+		if (speed2 > 0.f) {
+			t = glm::clamp(t + glm::dot(glm::vec3(point) - c, d) / speed2, start, end);
+		}
+	}
+	return t;
+}
+
+void BSplineFitter::AddPoint(const glm::vec4& point, float t, float weight) {
+	if (m_knots.empty()) {
+		return;
+	}
+	if (!m_corrections.empty()) {
+		t = CorrectParam(point, t);
+	}
+
+	int n = m_normal.n - 1;
+	int span = BSplineAlgorithms::FindSpan(n, m_degree, t, m_knots);
+	BSplineAlgorithms::BasisFuns(span, t, m_degree, m_knots, m_basis.data());
+	int first = span - m_degree;
+	for (int a = 0; a <= m_degree; ++a) {
+		double wa = double(weight) * m_basis[a];
+		for (int b = 0; b <= a; ++b) {
+			m_normal(first + a, first + b) += wa * m_basis[b];
+		}
+		m_rhs[first + a] += wa * glm::dvec4(point);
+	}
+	++m_pointCount;
+}
+
+void BSplineFitter::AddPoints(const glm::vec4* points, const float* params, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		AddPoint(points[i], params[i]);
+	}
+}
+
+bool BSplineFitter::Solve(std::vector<glm::vec4>& ctrlPoints) const {
+	if (m_knots.empty() || m_pointCount == 0) {
+		Log::errorToConsole("BSplineFitter::Solve no points were added");
+		return false;
+	}
+
+	BandedSystem::SymmetricBandedMatrix A = m_normal;
+	if (m_smoothing > 0.f && m_degree >= 2) {
+		// D^T D of the second differences, scaled to the average diagonal
+		double scale = 0.0;
+		for (int i = 0; i < A.n; ++i) {
+			scale += A(i, i);
+		}
+		double lambda = m_smoothing * scale / A.n;
+		for (int i = 1; i + 1 < A.n; ++i) {
+			const int rows[3] = { i - 1, i, i + 1 };
+			const double coefficients[3] = { 1.0, -2.0, 1.0 };
+			for (int a = 0; a < 3; ++a) {
+				for (int b = 0; b <= a; ++b) {
+					A(rows[a], rows[b]) += lambda * coefficients[a] * coefficients[b];
+				}
+			}
+		}
+	}
+
+	if (!BandedSystem::FactorCholesky(A)) {
+		Log::errorToConsole("BSplineFitter::Solve the normal equations are singular, add more points or smoothing");
+		return false;
+	}
+	std::vector<glm::dvec4> x = m_rhs;
+	BandedSystem::SolveCholesky(A, x);
+
+	ctrlPoints.resize(x.size());
+	for (int i = 0; i < x.size(); ++i) {
+		ctrlPoints[i] = glm::vec4(x[i]);
+	}
+	return true;
+}
+
+void BSplineFitter::BeginCorrection(const std::vector<glm::vec4>& ctrlPoints) {
+	if (ctrlPoints.size() != m_normal.n) {
+		Log::errorToConsole("BSplineFitter::BeginCorrection control point count does not match the fitter");
+		return;
+	}
+	m_corrections.push_back(ctrlPoints);
+	std::fill(m_normal.values.begin(), m_normal.values.end(), 0.0);
+	std::fill(m_rhs.begin(), m_rhs.end(), glm::dvec4(0));
+	m_pointCount = 0;
+}
+
+void BSplineFitter::Reset() {
+	m_corrections.clear();
+	std::fill(m_normal.values.begin(), m_normal.values.end(), 0.0);
+	std::fill(m_rhs.begin(), m_rhs.end(), glm::dvec4(0));
+	m_pointCount = 0;
+}
@@ -0,0 +1,88 @@
+#include "../../Headers/include_all.h"
+
+void BernsteinTableCache::Build(BernsteinTable& table) {
+	int n = table.degree;
+	int division = table.division;
+	table.weights.assign(division * (n + 1), 0.0);
+	table.derivatives.assign(division * (n + 1), 0.0);
+
+	// b holds B_{j,k}(t) for the current j, lower holds B_{n-1,k}(t)
+	std::vector<double> b(n + 1);
+	std::vector<double> lower(n + 1);
+	for (int i = 0; i < division; ++i) {
+		double t = division > 1 ? double(i) / double(division - 1) : 0.0;
+
+		// B_{j,k} = (1 - t) * B_{j-1,k} + t * B_{j-1,k-1}
+		std::fill(b.begin(), b.end(), 0.0);
+		b[0] = 1.0;
+		for (int j = 1; j <= n; ++j) {
+			if (j == n) {
+				lower = b;
+			}
+			for (int k = j; k > 0; --k) {
+				b[k] = (1.0 - t) * b[k] + t * b[k - 1];
+			}
+			b[0] *= 1.0 - t;
+		}
+
+		for (int k = 0; k <= n; ++k) {
+			table.weights[i * (n + 1) + k] = b[k];
+			// B'_{n,k} = n * (B_{n-1,k-1} - B_{n-1,k})
+			if (n > 0) {
+				double left = k > 0 ? lower[k - 1] : 0.0;
+				double right = k < n ? lower[k] : 0.0;
+				table.derivatives[i * (n + 1) + k] = n * (left - right);
+			}
+		}
+	}
+}
+
+BernsteinTable& BernsteinTableCache::GetLocked(int degree, int division) {
+	auto& table = m_tables[{ degree, division }];
+	if (table == nullptr) {
+		table = std::make_unique<BernsteinTable>();
+		table->degree = degree;
+		table->division = division;
+		Build(*table);
+	}
+	return *table;
+}
+
+const BernsteinTable& BernsteinTableCache::Get(int degree, int division) {
+	if (degree < 0 || division < 1) {
+		Log::errorToConsole("BernsteinTableCache::Get invalid degree or division");
+		degree = glm::max(degree, 0);
+		division = glm::max(division, 1);
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return GetLocked(degree, division);
+}
+
+GLuint BernsteinTableCache::GetSSBO(int degree, int division) {
+	if (degree < 0 || division < 1) {
+		Log::errorToConsole("BernsteinTableCache::GetSSBO invalid degree or division");
+		degree = glm::max(degree, 0);
+		division = glm::max(division, 1);
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	BernsteinTable& table = GetLocked(degree, division);
+	if (table.ssboID == 0) {
+		std::vector<float> data(table.weights.begin(), table.weights.end());
+		data.insert(data.end(), table.derivatives.begin(), table.derivatives.end());
+		glCreateBuffers(1, &table.ssboID);
+		glNamedBufferData(table.ssboID,
+			data.size() * sizeof(float),
+			data.data(),
+			GL_STATIC_DRAW);
+	}
+	return table.ssboID;
+}
+
+void BernsteinTableCache::Clean() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto& entry : m_tables) {
+		glDeleteBuffers(1, &entry.second->ssboID);
+		entry.second->ssboID = 0;
+	}
+	m_tables.clear();
+}
\ No newline at end of file
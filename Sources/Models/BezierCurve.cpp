@@ -3,16 +3,25 @@
 BezierCurve::BezierCurve(BezierCurveParams params) : ModelBase(BEZIERCURVE2MODELBASE) {
 	m_type = MODEL_TYPE_BEZIER;
 	m_smoothness = params.smoothness;
+	m_tessellationMode = params.tessellationMode;
+	SetTolerance(params.tolerance, params.screenSpaceTolerance);
 	m_ctrlPoints = {
 		glm::vec4{0,0,0,1},
 		glm::vec4{1,0,0,1},
 		glm::vec4{0,1,0,1},
 	};
 	SetCtrlPointsSSBO();
+	SetTessellationVBO();
 }
 BezierCurve::~BezierCurve() {
 	glDeleteBuffers(1, &m_ctrlPointsSSBOID);
 	m_ctrlPointsSSBOID = 0;
+	glDeleteBuffers(1, &m_coefficientsSSBOID);
+	m_coefficientsSSBOID = 0;
+	glDeleteBuffers(1, &m_tessellationVBOID);
+	m_tessellationVBOID = 0;
+	glDeleteVertexArrays(1, &m_tessellationVAOID);
+	m_tessellationVAOID = 0;
 }
 
 void BezierCurve::Render(RenderParams* p) {
@@ -46,10 +55,23 @@ void BezierCurve::Render(RenderParams* p) {
 		}
 		m_transform = acc;
 		transformsReset = true;
+		m_renderArcLengthDirty = true;
 	}
 
 	if (transformsReset || m_ctrlPointsDirty) {
 		WriteCtrlPointsSSBO();
+		m_ctrlPointsDirty = false;
+		m_tessellationDirty = true;
+	}
+
+	// -- Tessellate the curve if needed --
+	bool cached = GetTessellationMode() != TessellationMode::Shader;
+	if (GetTessellationMode() == TessellationMode::Adaptive && m_screenSpaceTolerance
+		&& (p->viewProj != m_tessellationViewProj || p->windowSize != m_tessellationViewport)) {
+		m_tessellationDirty = true;
+	}
+	if (cached && m_tessellationDirty) {
+		WriteTessellationVBO(p);
 	}
 
 	// -- Set render options --
@@ -64,8 +86,21 @@ void BezierCurve::Render(RenderParams* p) {
 	// -- Set shader input data --
 	// Bezier curve module
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, GetCtrlPointsSSBO());
-	glUniform1i(ul(progID, "bezierCurveData.ctrlPointCount"), GetCtrlPointCount());
+	glUniform1i(ul(progID, "bezierCurveData.ctrlPointCount"), GetDegree() + 1);
 	glUniform1i(ul(progID, "bezierCurveData.division"), GetSmoothness());
+	glUniform1i(ul(progID, "bezierCurveData.tessellated"), cached);
+	glUniform1i(ul(progID, "bezierCurveData.segmentCount"), GetSegmentCount());
+	// Arc length module
+	bool arcLength = !cached && GetArcLengthSampling();
+	glUniform1i(ul(progID, "arcLengthData.enabled"), arcLength);
+	if (arcLength) {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, GetRenderArcLengthTable().GetSSBO(GetSmoothness() * GetSegmentCount()));
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, m_coefficientsSSBOID);
+	}
+	// Bernstein table module
+	if (!cached) {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, BernsteinTableCache::GetSSBO(GetDegree(), GetSmoothness()));
+	}
 	// Camera module
 	glUniform3fv(ul(progID, "cameraData.eye"), 1, glm::value_ptr(p->cameraPos));
 	glUniformMatrix4fv(ul(progID, "cameraData.viewProj"), 1, GL_FALSE, glm::value_ptr(p->viewProj));
@@ -73,7 +108,14 @@ void BezierCurve::Render(RenderParams* p) {
 	glUniform3fv(ul(progID, "colorData.color"), 1, glm::value_ptr(GetColor()));
 	
 	// -- Draw call --
-	glDrawArrays(GetDrawMode(), 0, GetSmoothness());
+	if (cached) {
+		glBindVertexArray(m_tessellationVAOID);
+		glDrawArrays(GetDrawMode(), 0, m_tessellationVertexCount);
+		glBindVertexArray(0);
+	}
+	else {
+		glDrawArrays(GetDrawMode(), 0, GetSmoothness() * GetSegmentCount());
+	}
 
 	// -- Restore initial OGL state --
 	glLineWidth(lineWidth);
@@ -125,6 +167,26 @@ void BezierCurve::RenderGUI(std::vector<ModelBase*>* models) {
 	if (ImGui::SliderInt("Smoothness", &smoothness, 2, 64)) {
 		b->SetSmoothness(smoothness);
 	}
+	// tessellation
+	int mode = (int)b->GetTessellationMode();
+	if (ImGui::Combo("Tessellation", &mode, "Shader\0Cached\0Adaptive\0")) {
+		b->SetTessellationMode((TessellationMode)mode);
+	}
+	if (b->GetTessellationMode() != TessellationMode::Adaptive) {
+		bool arcLength = b->GetArcLengthSampling();
+		if (ImGui::Checkbox("Even spacing by arc length", &arcLength)) {
+			b->SetArcLengthSampling(arcLength);
+		}
+	}
+	if (b->GetTessellationMode() == TessellationMode::Adaptive) {
+		float tolerance = b->GetTolerance();
+		bool screenSpace = b->GetScreenSpaceTolerance();
+		bool changed = ImGui::DragFloat("Tolerance", &tolerance, 0.001f, 0.0001f, 10.f, "%.4f");
+		changed |= ImGui::Checkbox("Tolerance in pixels", &screenSpace);
+		if (changed) {
+			b->SetTolerance(tolerance, screenSpace);
+		}
+	}
 
 	// ctrl points
 	ImGui::Spacing();
@@ -174,6 +236,24 @@ void BezierCurve::RenderGUI(std::vector<ModelBase*>* models) {
 	if (ImGui::Button("Reduce degree")) {
 		b->Reduce();
 	}
+	ImGui::InputInt("Target degree", &m_bezierTargetDegree);
+	ImGui::SameLine();
+	if (ImGui::Button("Change degree")) {
+		b->ChangeDegree(m_bezierTargetDegree, &m_bezierDegreeDeviation);
+	}
+	ImGui::Text("Max deviation of the last degree change: %f", m_bezierDegreeDeviation);
+	ImGui::Text("Segments: %d", b->GetSegmentCount());
+	ImGui::Text("Length: %f", b->GetArcLengthTable().GetLength());
+	ImGui::InputInt("Cut count", &m_bezierCutCount);
+	ImGui::SameLine();
+	if (ImGui::Button("Cut into segments")) {
+		// uniformly spaced parameters
+		std::vector<float> params;
+		for (int i = 1; i <= m_bezierCutCount; ++i) {
+			params.push_back((float)i / (float)(m_bezierCutCount + 1));
+		}
+		b->Cut(params);
+	}
 	ImGui::SliderFloat("Cut param", &m_bezierCutParam, 0, 1, "%.2f");
 	ImGui::SameLine();
 	if (ImGui::Button("Cut")) {
@@ -188,6 +268,14 @@ void BezierCurve::RenderGUI(std::vector<ModelBase*>* models) {
 		}
 	}
 
+	// intersections
+	ImGui::DragFloat("Intersection tolerance", &m_intersectionTolerance, 0.0001f, 0.00001f, 1.f, "%.5f");
+	if (ImGui::Button("Intersect with other curves")) {
+		m_intersectionCount = CurveIntersector::IntersectWithScene(this, *models, m_intersectionTolerance);
+	}
+	ImGui::SameLine();
+	ImGui::Text("Intersections: %d", m_intersectionCount);
+
 	ImGui::Separator();
 	ImGui::Spacing();
 }
@@ -198,23 +286,45 @@ void RenderShadow(RenderParams* p, Light* l) {
 */
 
 void BezierCurve::Elevate() {
-	std::vector<glm::vec4> newCtrlPoints{};
-	int n = GetCtrlPoints().size() - 1;		// degree of the original curve
-	for (int k = 0; k <= n + 1; ++k) {
-		float alpha = (float)k / ((float)n + 1.f);
-		int index1 = glm::min(glm::max(k, 0), n);
-		int index2 = glm::min(glm::max(k - 1, 0), n);
-		newCtrlPoints.push_back((1 - alpha) * GetCtrlPoints()[index1] + alpha * GetCtrlPoints()[index2]);
-	}
-	m_ctrlPoints = newCtrlPoints;
-	m_ctrlPointsDirty = true;
+	ChangeDegree(GetDegree() + 1);
 }
 void BezierCurve::Reduce() {
 	if (GetCtrlPoints().size() < 3) {
 		Log::errorToConsole("Berier::Reduce curve cannot be reduced, too few control points");
 		return;
 	}
-	Log::logToConsole("This method is yet to be implemented");
+	float deviation = 0;
+	ChangeDegree(GetDegree() - 1, &deviation);
+	Log::logToConsole("Bezier-curve \"", GetName().c_str(), "\" reduced, max deviation: ", deviation);
+}
+bool BezierCurve::ChangeDegree(int target, float* maxDeviation, bool preserveEndpoints) {
+	int n = GetDegree();
+	if (n < 0 || target < 1) {
+		Log::errorToConsole("Bezier::ChangeDegree invalid target degree");
+		return false;
+	}
+
+	// every segment is changed separately
+	std::vector<glm::vec4> newCtrlPoints;
+	float deviation = 0;
+	for (int s = 0; s < GetSegmentCount(); ++s) {
+		std::vector<glm::vec4> segment = GetSegmentCtrlPoints(s);
+		std::vector<glm::vec4> newSegment;
+		if (target >= n) {
+			newSegment = BezierAlgorithms::ElevateDegree(segment, target - n);
+		}
+		else {
+			newSegment = BezierAlgorithms::ReduceDegree(segment, target, preserveEndpoints);
+			deviation = glm::max(deviation, BezierAlgorithms::MaxDeviation(segment, newSegment));
+		}
+		newCtrlPoints.insert(newCtrlPoints.end(), newSegment.begin(), newSegment.end());
+	}
+
+	if (maxDeviation != nullptr) {
+		*maxDeviation = deviation;
+	}
+	SetSegments(newCtrlPoints, GetSegmentCount());
+	return true;
 }
 void BezierCurve::Cut(float t, BezierCurve*& newCurve2) {
 	if (t < 0 || t > 1) {
@@ -222,22 +332,22 @@ void BezierCurve::Cut(float t, BezierCurve*& newCurve2) {
 		return;
 	}
 
-	int n = GetCtrlPoints().size() - 1;
-	std::vector<glm::vec4> col = GetCtrlPoints();
-	std::vector<glm::vec4> newCtrlPs1{};
-	std::vector<glm::vec4> newCtrlPs2{};
-	for (int i = 0; i <= n; ++i) {
-		// set new ctrl points
-		newCtrlPs1.push_back(col[0]);
-		newCtrlPs2.push_back(col[n - i]);
-		// calculate new column
-		for (int j = 0; j < n - i; ++j) {
-			col[j] = (1 - t) * col[j] + t * col[j + 1];
-		}
+	if (GetSegmentCount() > 1) {
+		Log::errorToConsole("Bezier::Cut not supported on curves with multiple segments");
+		return;
+	}
+
+	std::vector<glm::vec4> segments;
+	if (Split({ t }, segments) != 2) {
+		Log::errorToConsole("Bezier::Cut t param is at the end of the curve");
+		return;
 	}
+	int count = GetCtrlPointCount();
+	std::vector<glm::vec4> newCtrlPs2(segments.begin() + count, segments.end());
+	segments.resize(count);
 
 	// set this curve as first
-	SetCtrlPoints(newCtrlPs1);
+	SetCtrlPoints(segments);
 
 	// create second curve
 	std::stringstream name;
@@ -247,10 +357,75 @@ void BezierCurve::Cut(float t, BezierCurve*& newCurve2) {
 		GetProgramSelectedID(),
 		GetSmoothness(),
 		name.str().c_str(),
-		true
+		true,
+		GetTessellationMode(),
+		GetTolerance(),
+		GetScreenSpaceTolerance()
 		});
-	std::reverse(newCtrlPs2.begin(), newCtrlPs2.end());
 	newCurve2->SetCtrlPoints(newCtrlPs2);
 	newCurve2->SetTransforms(GetTransforms());
 	return;
+}
+int BezierCurve::Split(const std::vector<float>& params, std::vector<glm::vec4>& segments) const {
+	if (GetSegmentCount() > 1) {
+		Log::errorToConsole("Bezier::Split not supported on curves with multiple segments");
+		return 0;
+	}
+	return BezierAlgorithms::Split(m_ctrlPoints, params, segments);
+}
+void BezierCurve::GetBezierSpans(std::vector<std::vector<glm::vec4>>& spans, std::vector<float>& breaks, bool world) const {
+	spans.clear();
+	breaks = { 0 };
+	glm::mat4 transform = world && m_applyTransforms ? m_transform : glm::mat4(1);
+	for (int s = 0; s < GetSegmentCount(); ++s) {
+		spans.push_back(GetSegmentCtrlPoints(s));
+		for (auto& point : spans.back()) {
+			point = transform * point;
+		}
+		breaks.push_back(float(s + 1));
+	}
+}
+ArcLengthTable& BezierCurve::GetArcLengthTable() {
+	if (m_arcLengthDirty) {
+		std::vector<std::vector<glm::vec4>> segments;
+		std::vector<float> breaks;
+		GetBezierSpans(segments, breaks);
+		m_arcLengthTable.Build(segments, breaks);
+		m_arcLengthDirty = false;
+	}
+	return m_arcLengthTable;
+}
+ArcLengthTable& BezierCurve::GetRenderArcLengthTable() {
+	if (m_renderArcLengthDirty) {
+		std::vector<std::vector<glm::vec4>> segments;
+		std::vector<float> breaks;
+		GetBezierSpans(segments, breaks, true);
+		m_renderArcLengthTable.Build(segments, breaks);
+		m_renderArcLengthDirty = false;
+	}
+	return m_renderArcLengthTable;
+}
+glm::vec4 BezierCurve::GetPointAtLength(float s) {
+	float u = GetArcLengthTable().GetParam(s);
+	int segment = glm::clamp((int)u, 0, GetSegmentCount() - 1);
+	return GetEvaluator(segment).Evaluate(u - segment);
+}
+CurveProjector BezierCurve::GetProjector() const {
+	std::vector<std::vector<glm::vec4>> segments;
+	std::vector<float> breaks;
+	GetBezierSpans(segments, breaks);
+	return CurveProjector(segments, breaks);
+}
+std::vector<CurveProjection> BezierCurve::Project(const std::vector<glm::vec3>& points, int threadCount) const {
+	return GetProjector().Project(points, threadCount);
+}
+bool BezierCurve::Cut(const std::vector<float>& params) {
+	std::vector<glm::vec4> segments;
+	int segmentCount = Split(params, segments);
+	if (segmentCount == 0) {
+		Log::errorToConsole("Bezier::Cut unable to split the curve");
+		return false;
+	}
+	SetSegments(segments, segmentCount);
+	return true;
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "../../Headers/include_all.h"
+
+BezierEvaluator::BezierEvaluator(const glm::vec4* ctrlPoints, size_t count) {
+	SetCtrlPoints(ctrlPoints, count);
+}
+BezierEvaluator::BezierEvaluator(const std::vector<glm::vec4>& ctrlPoints) {
+	SetCtrlPoints(ctrlPoints);
+}
+
+void BezierEvaluator::SetCtrlPoints(const glm::vec4* ctrlPoints, size_t count) {
+	m_x.resize(count);
+	m_y.resize(count);
+	m_z.resize(count);
+	m_w.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		m_x[i] = ctrlPoints[i].x;
+		m_y[i] = ctrlPoints[i].y;
+		m_z[i] = ctrlPoints[i].z;
+		m_w[i] = ctrlPoints[i].w;
+	}
+}
+void BezierEvaluator::SetCtrlPoints(const std::vector<glm::vec4>& ctrlPoints) {
+	SetCtrlPoints(ctrlPoints.data(), ctrlPoints.size());
+}
+
+size_t BezierEvaluator::EvaluateScalar(const float* t, size_t count, float* outX, float* outY, float* outZ, float* outW, ScratchLane* scratch) const {
+	const int n = GetCtrlPointCount();
+	float* bx = reinterpret_cast<float*>(scratch);
+	float* by = bx + n;
+	float* bz = by + n;
+	float* bw = bz + n;
+
+	for (size_t i = 0; i < count; ++i) {
+		const float u = t[i];
+		const float s = 1.f - u;
+		std::copy(m_x.begin(), m_x.end(), bx);
+		std::copy(m_y.begin(), m_y.end(), by);
+		std::copy(m_z.begin(), m_z.end(), bz);
+		std::copy(m_w.begin(), m_w.end(), bw);
+		for (int r = n - 1; r > 0; --r) {
+			for (int k = 0; k < r; ++k) {
+				bx[k] = s * bx[k] + u * bx[k + 1];
+				by[k] = s * by[k] + u * by[k + 1];
+				bz[k] = s * bz[k] + u * bz[k + 1];
+				bw[k] = s * bw[k] + u * bw[k + 1];
+			}
+		}
+		outX[i] = bx[0];
+		outY[i] = by[0];
+		outZ[i] = bz[0];
+		outW[i] = bw[0];
+	}
+	return count;
+}
+
+#ifdef SIMD_SSE
+size_t BezierEvaluator::EvaluateSSE(const float* t, size_t count, float* outX, float* outY, float* outZ, float* outW, ScratchLane* scratch) const {
+	const int n = GetCtrlPointCount();
+	__m128* bx = reinterpret_cast<__m128*>(scratch);
+	__m128* by = bx + n;
+	__m128* bz = by + n;
+	__m128* bw = bz + n;
+	const __m128 one = _mm_set1_ps(1.f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 u = _mm_loadu_ps(t + i);
+		const __m128 s = _mm_sub_ps(one, u);
+		for (int k = 0; k < n; ++k) {
+			bx[k] = _mm_set1_ps(m_x[k]);
+			by[k] = _mm_set1_ps(m_y[k]);
+			bz[k] = _mm_set1_ps(m_z[k]);
+			bw[k] = _mm_set1_ps(m_w[k]);
+		}
+		for (int r = n - 1; r > 0; --r) {
+			for (int k = 0; k < r; ++k) {
+				bx[k] = _mm_add_ps(_mm_mul_ps(s, bx[k]), _mm_mul_ps(u, bx[k + 1]));
+				by[k] = _mm_add_ps(_mm_mul_ps(s, by[k]), _mm_mul_ps(u, by[k + 1]));
+				bz[k] = _mm_add_ps(_mm_mul_ps(s, bz[k]), _mm_mul_ps(u, bz[k + 1]));
+				bw[k] = _mm_add_ps(_mm_mul_ps(s, bw[k]), _mm_mul_ps(u, bw[k + 1]));
+			}
+		}
+		_mm_storeu_ps(outX + i, bx[0]);
+		_mm_storeu_ps(outY + i, by[0]);
+		_mm_storeu_ps(outZ + i, bz[0]);
+		_mm_storeu_ps(outW + i, bw[0]);
+	}
+	return i;
+}
+#endif
+
+#ifdef SIMD_AVX
+size_t BezierEvaluator::EvaluateAVX(const float* t, size_t count, float* outX, float* outY, float* outZ, float* outW, ScratchLane* scratch) const {
+	const int n = GetCtrlPointCount();
+	__m256* bx = reinterpret_cast<__m256*>(scratch);
+	__m256* by = bx + n;
+	__m256* bz = by + n;
+	__m256* bw = bz + n;
+	const __m256 one = _mm256_set1_ps(1.f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256 u = _mm256_loadu_ps(t + i);
+		const __m256 s = _mm256_sub_ps(one, u);
+		for (int k = 0; k < n; ++k) {
+			bx[k] = _mm256_broadcast_ss(&m_x[k]);
+			by[k] = _mm256_broadcast_ss(&m_y[k]);
+			bz[k] = _mm256_broadcast_ss(&m_z[k]);
+			bw[k] = _mm256_broadcast_ss(&m_w[k]);
+		}
+		for (int r = n - 1; r > 0; --r) {
+			for (int k = 0; k < r; ++k) {
+				bx[k] = _mm256_add_ps(_mm256_mul_ps(s, bx[k]), _mm256_mul_ps(u, bx[k + 1]));
+				by[k] = _mm256_add_ps(_mm256_mul_ps(s, by[k]), _mm256_mul_ps(u, by[k + 1]));
+				bz[k] = _mm256_add_ps(_mm256_mul_ps(s, bz[k]), _mm256_mul_ps(u, bz[k + 1]));
+				bw[k] = _mm256_add_ps(_mm256_mul_ps(s, bw[k]), _mm256_mul_ps(u, bw[k + 1]));
+			}
+		}
+		_mm256_storeu_ps(outX + i, bx[0]);
+		_mm256_storeu_ps(outY + i, by[0]);
+		_mm256_storeu_ps(outZ + i, bz[0]);
+		_mm256_storeu_ps(outW + i, bw[0]);
+	}
+	return i;
+}
+#endif
+
+glm::vec4 BezierEvaluator::Evaluate(float t) const {
+	glm::vec4 result(0);
+	Evaluate(&t, 1, &result);
+	return result;
+}
+
+void BezierEvaluator::Evaluate(const float* t, size_t count, float* outX, float* outY, float* outZ, float* outW) const {
+	if (GetCtrlPointCount() == 0) {
+		Log::errorToConsole("BezierEvaluator::Evaluate has no control points");
+		std::fill(outX, outX + count, 0.f);
+		std::fill(outY, outY + count, 0.f);
+		std::fill(outZ, outZ + count, 0.f);
+		std::fill(outW, outW + count, 0.f);
+		return;
+	}
+
+	// one scratch for every kernel of the batch, without a heap allocation for the usual degrees
+	const int n = GetCtrlPointCount();
+	std::array<ScratchLane, 4 * STACK_CTRL_POINTS> stackScratch;
+	std::vector<ScratchLane> heapScratch;
+	ScratchLane* scratch = stackScratch.data();
+	if (n > STACK_CTRL_POINTS) {
+		heapScratch.resize(4 * n);
+		scratch = heapScratch.data();
+	}
+
+	// widest lanes first, the remainder is handled by the narrower kernels,
+	// a kernel is skipped when the remainder does not fill its lanes
+	size_t done = 0;
+#ifdef SIMD_AVX
+	if (count - done >= 8) {
+		done += EvaluateAVX(t + done, count - done, outX + done, outY + done, outZ + done, outW + done, scratch);
+	}
+#endif
+#ifdef SIMD_SSE
+	if (count - done >= 4) {
+		done += EvaluateSSE(t + done, count - done, outX + done, outY + done, outZ + done, outW + done, scratch);
+	}
+#endif
+	EvaluateScalar(t + done, count - done, outX + done, outY + done, outZ + done, outW + done, scratch);
+}
+
+void BezierEvaluator::Evaluate(const float* t, size_t count, glm::vec4* out) const {
+	// evaluate in fixed size blocks, then interleave the coordinates
+	constexpr size_t blockSize = 256;
+	std::array<float, blockSize> x, y, z, w;
+	for (size_t begin = 0; begin < count; begin += blockSize) {
+		const size_t size = std::min(blockSize, count - begin);
+		Evaluate(t + begin, size, x.data(), y.data(), z.data(), w.data());
+		for (size_t i = 0; i < size; ++i) {
+			out[begin + i] = glm::vec4(x[i], y[i], z[i], w[i]);
+		}
+	}
+}
+
+void BezierEvaluator::Evaluate(const std::vector<float>& t, std::vector<glm::vec4>& out) const {
+	out.resize(t.size());
+	Evaluate(t.data(), t.size(), out.data());
+}
+
+void BezierEvaluator::EvaluateUniform(int division, std::vector<glm::vec4>& out) const {
+	if (division < 2) {
+		Log::errorToConsole("BezierEvaluator::EvaluateUniform division has to be at least 2");
+		out.clear();
+		return;
+	}
+	std::vector<float> t(division);
+	const float deltaT = 1.f / float(division - 1);
+	for (int i = 0; i < division; ++i) {
+		t[i] = float(i) * deltaT;
+	}
+	Evaluate(t, out);
+}
\ No newline at end of file
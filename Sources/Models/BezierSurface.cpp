@@ -4,19 +4,99 @@ BezierSurface::BezierSurface(BezierSurfaceParams params) : ModelBase(BEZIERSURFA
 	m_wireframe = params.wireframe;
 	m_type = MODEL_TYPE_BEZIERSURFACE;
 	m_smoothness = params.smoothness;
+	m_evaluation = params.evaluation;
+	m_gridProgramID = params.programGridID;
 	SetCtrlPointsSSBO();
 }
 BezierSurface::~BezierSurface() {
 	glDeleteBuffers(1, &m_ctrlPointsSSBOID);
 	m_ctrlPointsSSBOID = 0;
+	glDeleteBuffers(1, &m_coefficientsSSBOID);
+	m_coefficientsSSBOID = 0;
 	glDeleteBuffers(1, &m_interpolatedPointsSSBOID);
 	m_interpolatedPointsSSBOID = 0;
+	glDeleteBuffers(1, &m_gridSSBOID);
+	m_gridSSBOID = 0;
+	glDeleteBuffers(1, &m_curvesSSBOID);
+	m_curvesSSBOID = 0;
+	glDeleteVertexArrays(1, &m_gridVAOID);
+	m_gridVAOID = 0;
 
 	if (m_material != nullptr) {
 		delete(m_material);
 	}
 }
 
+bool BezierSurface::UpdateGrid() {
+	m_gridDirty = false;
+	m_gridValid = false;
+	const glm::ivec2 division = GetSmoothness();
+	const int rows = GetRowsCount();
+	const int cols = GetColsCount();
+	if (rows < 1 || cols < 1 || m_ctrlPoints.size() != rows * cols || division.x < 2 || division.y < 2) {
+		Log::errorToConsole("BezierSurface::UpdateGrid control points or division are invalid, the shader evaluates the surface");
+		return false;
+	}
+	if (m_gridSSBOID == 0) {
+		glCreateBuffers(1, &m_gridSSBOID);
+		glCreateBuffers(1, &m_curvesSSBOID);
+	}
+	const int gridSize = 2 * division.x * division.y;
+
+	if (m_evaluation == SurfaceEvaluation::Compute && m_gridProgramID != 0) {
+		const int curvesSize = 2 * division.x * rows;
+		if (gridSize > m_gridCapacity) {
+			m_gridCapacity = gridSize;
+			glNamedBufferData(m_gridSSBOID, gridSize * sizeof(glm::vec4), nullptr, GL_DYNAMIC_COPY);
+		}
+		if (curvesSize > m_curvesCapacity) {
+			m_curvesCapacity = curvesSize;
+			glNamedBufferData(m_curvesSSBOID, curvesSize * sizeof(glm::vec4), nullptr, GL_DYNAMIC_COPY);
+		}
+
+		glUseProgram(m_gridProgramID);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, GetCtrlPointsSSBO());
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, BernsteinTableCache::GetSSBO(cols - 1, division.x));
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, BernsteinTableCache::GetSSBO(rows - 1, division.y));
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, m_gridSSBOID);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, m_curvesSSBOID);
+		glUniform2iv(ul(m_gridProgramID, "bezierSurfaceData.ctrlPointCount"), 1, glm::value_ptr(GetDimensions()));
+		glUniform2iv(ul(m_gridProgramID, "bezierSurfaceData.division"), 1, glm::value_ptr(division));
+
+		// stage one: every row at every u sample
+		glUniform1i(ul(m_gridProgramID, "bezierSurfaceGridData.stage"), 1);
+		glDispatchCompute((division.x * rows + 63) / 64, 1, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		// stage two: every sample from the rows of its u sample
+		glUniform1i(ul(m_gridProgramID, "bezierSurfaceGridData.stage"), 2);
+		glDispatchCompute((division.x * division.y + 63) / 64, 1, 1);
+		// the vertex shader reads the grid
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		glUseProgram(0);
+		m_gridValid = true;
+		return true;
+	}
+
+	// the same stages on the CPU, on the transformed control points like the SSBO
+	std::vector<glm::vec4> points;
+	for (const auto& point : m_ctrlPoints) {
+		points.push_back(m_applyTransforms ? GetTransform() * point : point);
+	}
+	if (!m_evaluator.Build(points, rows, cols, division)) {
+		return false;
+	}
+	const std::vector<glm::vec4>& grid = m_evaluator.GetGrid();
+	if (gridSize > m_gridCapacity) {
+		m_gridCapacity = gridSize;
+		glNamedBufferData(m_gridSSBOID, gridSize * sizeof(glm::vec4), grid.data(), GL_DYNAMIC_DRAW);
+	}
+	else {
+		glNamedBufferSubData(m_gridSSBOID, 0, gridSize * sizeof(glm::vec4), grid.data());
+	}
+	m_gridValid = true;
+	return true;
+}
+
 void BezierSurface::Render(RenderParams* p) {
 	// -- Render selection if needed --
 	if (p->selected) {
@@ -67,8 +147,18 @@ void BezierSurface::Render(RenderParams* p) {
 	if (transformsReset || m_ctrlPointsDirty) {
 		WriteCtrlPointsSSBO();
 		WriteInterpolatedPointsSSBO();
+		m_ctrlPointsDirty = false;
+		m_gridDirty = true;
 	}
 
+	// -- Evaluate the sample grid if needed --
+	bool cachedGrid = m_evaluation != SurfaceEvaluation::Shader;
+	if (cachedGrid && m_gridDirty) {
+		UpdateGrid();
+	}
+	// without a valid grid the vertex shader evaluates the surface
+	cachedGrid = cachedGrid && m_gridValid;
+
 	// -- Set render options --
 	bool cullFaceEnabled = glIsEnabled(GL_CULL_FACE);
 	glDisable(GL_CULL_FACE);
@@ -93,6 +183,15 @@ void BezierSurface::Render(RenderParams* p) {
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, GetCtrlPointsSSBO());
 	glUniform2iv(ul(progID, "bezierSurfaceData.ctrlPointCount"), 1, glm::value_ptr(GetDimensions()));
 	glUniform2iv(ul(progID, "bezierSurfaceData.division"), 1, glm::value_ptr(GetSmoothness()));
+	glUniform1i(ul(progID, "bezierSurfaceData.horner"), GetHornerEvaluation());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, m_coefficientsSSBOID);
+	glUniform1i(ul(progID, "bezierSurfaceData.cachedGrid"), cachedGrid);
+	if (cachedGrid) {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, m_gridSSBOID);
+	}
+	// Bernstein table module (u direction runs along the columns, v along the rows)
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, BernsteinTableCache::GetSSBO(GetColsCount() - 1, GetSmoothness().x));
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, BernsteinTableCache::GetSSBO(GetRowsCount() - 1, GetSmoothness().y));
 	// Camera module
 	glUniform3fv(ul(progID, "cameraData.eye"), 1, glm::value_ptr(p->cameraPos));
 	glUniformMatrix4fv(ul(progID, "cameraData.viewProj"), 1, GL_FALSE, glm::value_ptr(p->viewProj));
@@ -108,7 +207,19 @@ void BezierSurface::Render(RenderParams* p) {
 	glUniform1i(ul(progID, "lightData.lightCount"), p->lightCount);
 
 	// -- Draw call --
-	glDrawArrays(GetDrawMode(), 0, (GetSmoothness().x - 1) * (GetSmoothness().y - 1) * 2 * 3);
+	// every sample is a vertex once, the triangles index the samples shared with their neighbours
+	GLuint indexBufferID = GridIndexCache::Get(GetSmoothness());
+	if (m_gridVAOID == 0) {
+		// no vertex attributes, the shader evaluates or reads the sample of gl_VertexID
+		glCreateVertexArrays(1, &m_gridVAOID);
+	}
+	if (indexBufferID != m_gridIndexBufferID) {
+		m_gridIndexBufferID = indexBufferID;
+		glVertexArrayElementBuffer(m_gridVAOID, m_gridIndexBufferID);
+	}
+	glBindVertexArray(m_gridVAOID);
+	glDrawElements(GetDrawMode(), GridIndexCache::GetIndexCount(GetSmoothness()), GL_UNSIGNED_INT, nullptr);
+	glBindVertexArray(0);
 
 	// -- Restore initial OGL state --
 	if (cullFaceEnabled) glEnable(GL_CULL_FACE);
@@ -240,6 +351,18 @@ void BezierSurface::RenderGUI(std::vector<ModelBase*>* models) {
 		b->SetWireFrame(wireframe);
 	}
 
+	// Evaluation
+	int evaluation = (int)b->GetSurfaceEvaluation();
+	if (ImGui::Combo("Evaluation", &evaluation, "Shader\0CPU grid\0Compute grid\0")) {
+		b->SetSurfaceEvaluation((SurfaceEvaluation)evaluation);
+	}
+	if (b->GetSurfaceEvaluation() == SurfaceEvaluation::Shader) {
+		bool horner = b->GetHornerEvaluation();
+		if (ImGui::Checkbox("Horner evaluation", &horner)) {
+			b->SetHornerEvaluation(horner);
+		}
+	}
+
 	// ctrl points
 	/*
 	ImGui::Spacing();
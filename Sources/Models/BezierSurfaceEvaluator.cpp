@@ -0,0 +1,71 @@
+#include "../../Headers/include_all.h"
+
+bool BezierSurfaceEvaluator::BuildCurves(const std::vector<glm::vec4>& ctrlPoints, int rows, int cols, int divisionU) {
+	if (rows < 1 || cols < 1 || ctrlPoints.size() != rows * cols) {
+		Log::errorToConsole("BezierSurfaceEvaluator::BuildCurves control points do not match the dimensions");
+		return false;
+	}
+	if (divisionU < 2) {
+		Log::errorToConsole("BezierSurfaceEvaluator::BuildCurves division has to be at least 2");
+		return false;
+	}
+	m_rows = rows;
+	m_cols = cols;
+	m_division = glm::ivec2(divisionU, 0);
+	m_grid.clear();
+
+	const BernsteinTable& table = BernsteinTableCache::Get(cols - 1, divisionU);
+	m_curves.resize(2 * divisionU * rows);
+	for (int iu = 0; iu < divisionU; ++iu) {
+		for (int i = 0; i < rows; ++i) {
+			glm::dvec3 point(0);
+			glm::dvec3 du(0);
+			for (int j = 0; j < cols; ++j) {
+				glm::dvec3 ctrlPoint = glm::dvec3(ctrlPoints[i * cols + j]);
+				point += table.Weight(iu, j) * ctrlPoint;
+				du += table.Derivative(iu, j) * ctrlPoint;
+			}
+			m_curves[2 * (iu * rows + i)] = glm::vec4(point, 1);
+			m_curves[2 * (iu * rows + i) + 1] = glm::vec4(du, 0);
+		}
+	}
+	return true;
+}
+
+void BezierSurfaceEvaluator::EvaluateGrid(int divisionV) {
+	if (m_curves.empty() || divisionV < 2) {
+		Log::errorToConsole("BezierSurfaceEvaluator::EvaluateGrid needs the curves of stage one and a division of at least 2");
+		return;
+	}
+	m_division.y = divisionV;
+
+	const BernsteinTable& table = BernsteinTableCache::Get(m_rows - 1, divisionV);
+	m_grid.resize(2 * m_division.x * divisionV);
+	for (int iv = 0; iv < divisionV; ++iv) {
+		for (int iu = 0; iu < m_division.x; ++iu) {
+			const glm::vec4* curves = &m_curves[2 * iu * m_rows];
+			glm::dvec3 point(0);
+			glm::dvec3 du(0);
+			glm::dvec3 dv(0);
+			for (int i = 0; i < m_rows; ++i) {
+				double weight = table.Weight(iv, i);
+				point += weight * glm::dvec3(curves[2 * i]);
+				du += weight * glm::dvec3(curves[2 * i + 1]);
+				dv += table.Derivative(iv, i) * glm::dvec3(curves[2 * i]);
+			}
+			// the same orientation as the vertex shader
+			glm::dvec3 normal = glm::cross(dv, du);
+			double length = glm::length(normal);
+			m_grid[2 * (iv * m_division.x + iu)] = glm::vec4(point, 1);
+			m_grid[2 * (iv * m_division.x + iu) + 1] = glm::vec4(length > 0.0 ? normal / length : normal, 0);
+		}
+	}
+}
+
+bool BezierSurfaceEvaluator::Build(const std::vector<glm::vec4>& ctrlPoints, int rows, int cols, glm::ivec2 division) {
+	if (!BuildCurves(ctrlPoints, rows, cols, division.x)) {
+		return false;
+	}
+	EvaluateGrid(division.y);
+	return !m_grid.empty();
+}
@@ -0,0 +1,296 @@
+#include "../../Headers/include_all.h"
+
+static bool BoxesOverlap(const glm::vec3& minA, const glm::vec3& maxA, const glm::vec3& minB, const glm::vec3& maxB, float tolerance) {
+	for (int i = 0; i < 3; ++i) {
+		if (minA[i] > maxB[i] + tolerance || minB[i] > maxA[i] + tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// the control points are homogeneous, the point and the derivative are projected with the quotient rule
+static glm::vec3 DeCasteljau(const std::vector<glm::vec4>& points, float t, glm::vec3* derivative) {
+	int n = points.size() - 1;
+	std::vector<glm::vec4> col = points;
+	glm::vec4 d(0);
+	for (int r = n; r > 0; --r) {
+		if (r == 1) {
+			d = float(n) * (col[1] - col[0]);
+		}
+		for (int k = 0; k < r; ++k) {
+			col[k] = (1.f - t) * col[k] + t * col[k + 1];
+		}
+	}
+	glm::vec3 c, c1;
+	BezierAlgorithms::RationalDerivatives(col[0], d, nullptr, c, c1, nullptr);
+	if (derivative != nullptr) {
+		*derivative = c1;
+	}
+	return c;
+}
+
+int CurveIntersector::AddCurve(const std::vector<std::vector<glm::vec4>>& spans, const std::vector<float>& breaks) {
+	if (spans.empty() || breaks.size() != spans.size() + 1) {
+		Log::errorToConsole("CurveIntersector::AddCurve break count does not match the span count");
+		return -1;
+	}
+	for (int i = 0; i < spans.size(); ++i) {
+		Piece piece = MakePiece(spans[i], 0.f, 1.f);
+		Span span;
+		span.curve = m_curveCount;
+		span.points = spans[i];
+		span.start = breaks[i];
+		span.end = breaks[i + 1];
+		span.min = piece.min;
+		span.max = piece.max;
+		m_spans.push_back(span);
+	}
+	return m_curveCount++;
+}
+
+int CurveIntersector::AddModel(ModelBase* model) {
+	std::vector<std::vector<glm::vec4>> spans;
+	std::vector<float> breaks;
+	switch (model->GetType()) {
+	case MODEL_TYPE_BEZIER:
+		((BezierCurve*)model)->GetBezierSpans(spans, breaks, true);
+		break;
+	case MODEL_TYPE_BSPLINE:
+		((BSpline*)model)->GetBezierSpans(spans, breaks, true);
+		break;
+	default:
+		return -1;
+	}
+	if (spans.empty()) {
+		return -1;
+	}
+	return AddCurve(spans, breaks);
+}
+
+int CurveIntersector::IntersectWithScene(ModelBase* model, const std::vector<ModelBase*>& models, float tolerance) {
+	CurveIntersector intersector;
+	std::vector<ModelBase*> curves;		// model of every curve index
+	int self = -1;
+	for (auto m : models) {
+		int index = intersector.AddModel(m);
+		if (index < 0) {
+			continue;
+		}
+		curves.push_back(m);
+		if (m == model) {
+			self = index;
+		}
+	}
+	if (self < 0) {
+		Log::errorToConsole("CurveIntersector::IntersectWithScene model is not a curve of the scene");
+		return 0;
+	}
+
+	std::vector<CurveIntersection> intersections = intersector.Intersect(tolerance, self);
+	for (const auto& i : intersections) {
+		Log::logToConsole("Intersection of \"", curves[i.curveA]->GetName().c_str(), "\" (t = ", i.tA,
+			") and \"", curves[i.curveB]->GetName().c_str(), "\" (t = ", i.tB,
+			") at ", i.point.x, " ", i.point.y, " ", i.point.z);
+	}
+	return intersections.size();
+}
+
+CurveIntersector::Piece CurveIntersector::MakePiece(const std::vector<glm::vec4>& points, float t0, float t1) {
+	Piece piece;
+	piece.points = points;
+	piece.t0 = t0;
+	piece.t1 = t1;
+	piece.min = BezierAlgorithms::Dehomogenize(points[0]);
+	piece.max = piece.min;
+	for (const auto& point : points) {
+		piece.min = glm::min(piece.min, glm::vec3(BezierAlgorithms::Dehomogenize(point)));
+		piece.max = glm::max(piece.max, glm::vec3(BezierAlgorithms::Dehomogenize(point)));
+	}
+	return piece;
+}
+
+void CurveIntersector::Subdivide(const Piece& a, const Piece& b, float tolerance, int depth, std::vector<Hit>& hits) {
+	if (hits.size() >= MAX_HITS || !BoxesOverlap(a.min, a.max, b.min, b.max, tolerance)) {
+		return;
+	}
+	float sizeA = glm::length(a.max - a.min);
+	float sizeB = glm::length(b.max - b.min);
+	if ((sizeA <= tolerance && sizeB <= tolerance) || depth >= MAX_DEPTH) {
+		hits.push_back({ a.t0, a.t1, b.t0, b.t1 });
+		return;
+	}
+
+	// halve the larger piece
+	std::vector<glm::vec4> left, right;
+	if (sizeA >= sizeB) {
+		CurveTessellation::SplitBezier(a.points, 0.5f, left, right);
+		float mid = 0.5f * (a.t0 + a.t1);
+		Subdivide(MakePiece(left, a.t0, mid), b, tolerance, depth + 1, hits);
+		Subdivide(MakePiece(right, mid, a.t1), b, tolerance, depth + 1, hits);
+	}
+	else {
+		CurveTessellation::SplitBezier(b.points, 0.5f, left, right);
+		float mid = 0.5f * (b.t0 + b.t1);
+		Subdivide(a, MakePiece(left, b.t0, mid), tolerance, depth + 1, hits);
+		Subdivide(a, MakePiece(right, mid, b.t1), tolerance, depth + 1, hits);
+	}
+}
+
+void CurveIntersector::IntersectSpans(const Span& a, const Span& b, float tolerance, std::vector<CurveIntersection>& out) const {
+	std::vector<Hit> hits;
+	Subdivide(MakePiece(a.points, 0.f, 1.f), MakePiece(b.points, 0.f, 1.f), tolerance, 0, hits);
+	if (hits.empty()) {
+		return;
+	}
+
+	// hits with touching parameter ranges on both curves belong to the same intersection:
+	// sweep and prune along the range on curve a, union-find joins the hits overlapping on curve b as well
+	std::sort(hits.begin(), hits.end(), [](const Hit& l, const Hit& r) {
+		return l.a0 < r.a0;
+	});
+	std::vector<int> parent(hits.size());
+	std::iota(parent.begin(), parent.end(), 0);
+	auto root = [&parent](int i) {
+		while (parent[i] != i) {
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	};
+	std::vector<int> active;
+	for (int i = 0; i < hits.size(); ++i) {
+		const Hit& h = hits[i];
+		active.erase(std::remove_if(active.begin(), active.end(), [&](int j) {
+			return hits[j].a1 + CurveTessellation::EPSILON < h.a0;
+		}), active.end());
+
+		for (int j : active) {
+			const Hit& o = hits[j];
+			if (h.b0 <= o.b1 + CurveTessellation::EPSILON && o.b0 <= h.b1 + CurveTessellation::EPSILON) {
+				parent[root(i)] = root(j);
+			}
+		}
+		active.push_back(i);
+	}
+
+	// hits of every cluster in one pass
+	std::vector<std::vector<int>> clusters;
+	std::vector<int> clusterOfRoot(hits.size(), -1);
+	for (int i = 0; i < hits.size(); ++i) {
+		int r = root(i);
+		if (clusterOfRoot[r] < 0) {
+			clusterOfRoot[r] = clusters.size();
+			clusters.emplace_back();
+		}
+		clusters[clusterOfRoot[r]].push_back(i);
+	}
+
+	for (const auto& cluster : clusters) {
+		// start from the closest hit of the cluster
+		float s = 0, t = 0;
+		float best = std::numeric_limits<float>::max();
+		for (int i : cluster) {
+			float si = 0.5f * (hits[i].a0 + hits[i].a1);
+			float ti = 0.5f * (hits[i].b0 + hits[i].b1);
+			float distance = glm::length(DeCasteljau(a.points, si, nullptr) - DeCasteljau(b.points, ti, nullptr));
+			if (distance < best) {
+				best = distance;
+				s = si;
+				t = ti;
+			}
+		}
+
+		// Gauss-Newton on r(s, t) = A(s) - B(t)
+		for (int i = 0; i < NEWTON_ITERATIONS; ++i) {
+			glm::vec3 da, db;
+			glm::vec3 r = DeCasteljau(a.points, s, &da) - DeCasteljau(b.points, t, &db);
+			float m00 = glm::dot(da, da);
+			float m01 = -glm::dot(da, db);
+			float m11 = glm::dot(db, db);
+			float det = m00 * m11 - m01 * m01;
+			if (std::abs(det) < CurveTessellation::EPSILON * m00 * m11 || glm::dot(r, r) == 0.f) {
+				break;		// tangential or exact hit, keep the subdivision result
+			}
+			float g0 = glm::dot(da, r);
+			float g1 = -glm::dot(db, r);
+			float ns = glm::clamp(s - (m11 * g0 - m01 * g1) / det, 0.f, 1.f);
+			float nt = glm::clamp(t - (m00 * g1 - m01 * g0) / det, 0.f, 1.f);
+			float distance = glm::length(DeCasteljau(a.points, ns, nullptr) - DeCasteljau(b.points, nt, nullptr));
+			if (distance >= best) {
+				break;
+			}
+			best = distance;
+			s = ns;
+			t = nt;
+		}
+
+		CurveIntersection intersection;
+		intersection.curveA = a.curve;
+		intersection.curveB = b.curve;
+		intersection.tA = glm::mix(a.start, a.end, s);
+		intersection.tB = glm::mix(b.start, b.end, t);
+		intersection.point = 0.5f * (DeCasteljau(a.points, s, nullptr) + DeCasteljau(b.points, t, nullptr));
+		out.push_back(intersection);
+	}
+}
+
+std::vector<CurveIntersection> CurveIntersector::Intersect(float tolerance, int curve) const {
+	tolerance = glm::max(tolerance, CurveTessellation::EPSILON);
+
+	// sweep and prune along x
+	std::vector<int> order(m_spans.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](int i, int j) {
+		return m_spans[i].min.x < m_spans[j].min.x;
+	});
+
+	std::vector<CurveIntersection> result;
+	std::vector<int> active;
+	for (int index : order) {
+		const Span& span = m_spans[index];
+		active.erase(std::remove_if(active.begin(), active.end(), [&](int i) {
+			return m_spans[i].max.x + tolerance < span.min.x;
+		}), active.end());
+
+		for (int other : active) {
+			const Span& a = m_spans[other];
+			if (a.curve == span.curve || (curve >= 0 && a.curve != curve && span.curve != curve)
+				|| !BoxesOverlap(a.min, a.max, span.min, span.max, tolerance)) {
+				continue;
+			}
+			// keep the order of the curves stable
+			if (a.curve < span.curve) {
+				IntersectSpans(a, span, tolerance, result);
+			}
+			else {
+				IntersectSpans(span, a, tolerance, result);
+			}
+		}
+		active.push_back(index);
+	}
+
+	// neighbouring spans of a curve share their end points, the duplicates have the same parameters
+	// and are next to each other once the results are sorted by curves and parameters
+	std::sort(result.begin(), result.end(), [](const CurveIntersection& l, const CurveIntersection& r) {
+		if (l.curveA != r.curveA) {
+			return l.curveA < r.curveA;
+		}
+		if (l.curveB != r.curveB) {
+			return l.curveB < r.curveB;
+		}
+		if (l.tA != r.tA) {
+			return l.tA < r.tA;
+		}
+		return l.tB < r.tB;
+	});
+	std::vector<CurveIntersection> unique;
+	for (const auto& intersection : result) {
+		if (!unique.empty() && unique.back().curveA == intersection.curveA && unique.back().curveB == intersection.curveB
+			&& glm::length(unique.back().point - intersection.point) <= tolerance) {
+			continue;
+		}
+		unique.push_back(intersection);
+	}
+	return unique;
+}
\ No newline at end of file
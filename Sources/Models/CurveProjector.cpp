@@ -0,0 +1,241 @@
+#include "../../Headers/include_all.h"
+
+static glm::vec4 DeCasteljau(const std::vector<glm::vec4>& points, float t) {
+	if (points.empty()) {
+		return glm::vec4(0);
+	}
+	std::vector<glm::vec4> col = points;
+	for (int r = col.size() - 1; r > 0; --r) {
+		for (int k = 0; k < r; ++k) {
+			col[k] = (1.f - t) * col[k] + t * col[k + 1];
+		}
+	}
+	return col[0];
+}
+
+static std::vector<glm::vec4> Hodograph(const std::vector<glm::vec4>& points) {
+	int n = points.size() - 1;
+	std::vector<glm::vec4> d;
+	for (int k = 0; k < n; ++k) {
+		d.push_back(float(n) * (points[k + 1] - points[k]));
+	}
+	return d;
+}
+
+static float BoxDistance2(const glm::vec3& p, const glm::vec3& min, const glm::vec3& max) {
+	glm::vec3 d = glm::max(glm::max(min - p, p - max), glm::vec3(0));
+	return glm::dot(d, d);
+}
+
+glm::vec3 CurveProjector::Span::Evaluate(float t) const {
+	glm::vec4 a = DeCasteljau(points, t);
+	return rational ? glm::vec3(BezierAlgorithms::Dehomogenize(a)) : glm::vec3(a);
+}
+
+void CurveProjector::Span::Evaluate(float t, glm::vec3& c, glm::vec3& c1, glm::vec3& c2) const {
+	glm::vec4 a = DeCasteljau(points, t);
+	glm::vec4 a1 = DeCasteljau(d1, t);
+	glm::vec4 a2 = DeCasteljau(d2, t);
+	if (!rational) {
+		c = a;
+		c1 = a1;
+		c2 = a2;
+		return;
+	}
+	BezierAlgorithms::RationalDerivatives(a, a1, &a2, c, c1, &c2);
+}
+
+CurveProjector::CurveProjector(const std::vector<std::vector<glm::vec4>>& spans, const std::vector<float>& breaks) {
+	if (spans.empty() || breaks.size() != spans.size() + 1) {
+		Log::errorToConsole("CurveProjector::CurveProjector break count does not match the span count");
+		return;
+	}
+
+	for (int i = 0; i < spans.size(); ++i) {
+		Span span;
+		span.points = spans[i];
+		span.rational = BezierAlgorithms::IsRational(spans[i]);
+		span.d1 = Hodograph(span.points);
+		span.d2 = Hodograph(span.d1);
+		span.start = breaks[i];
+		span.end = breaks[i + 1];
+		m_spans.push_back(span);
+
+		// flatness tolerance relative to the size of the span
+		glm::vec3 min = BezierAlgorithms::Dehomogenize(span.points[0]);
+		glm::vec3 max = min;
+		for (const auto& point : span.points) {
+			min = glm::min(min, glm::vec3(BezierAlgorithms::Dehomogenize(point)));
+			max = glm::max(max, glm::vec3(BezierAlgorithms::Dehomogenize(point)));
+		}
+		float tolerance = glm::max(FLATNESS * glm::length(max - min), CurveTessellation::EPSILON);
+		m_roots.push_back(BuildNode(i, spans[i], 0.f, 1.f, tolerance, 0));
+	}
+}
+
+int CurveProjector::BuildNode(int span, const std::vector<glm::vec4>& piece, float t0, float t1, float tolerance, int depth) {
+	// with positive weights the curve stays in the box of the projected control points
+	Node node;
+	node.min = BezierAlgorithms::Dehomogenize(piece[0]);
+	node.max = node.min;
+	for (const auto& point : piece) {
+		node.min = glm::min(node.min, glm::vec3(BezierAlgorithms::Dehomogenize(point)));
+		node.max = glm::max(node.max, glm::vec3(BezierAlgorithms::Dehomogenize(point)));
+	}
+	node.span = span;
+	node.t0 = t0;
+	node.t1 = t1;
+	int index = m_nodes.size();
+	m_nodes.push_back(node);
+
+	CurveTessellation::AdaptiveParams flatness;
+	flatness.tolerance = tolerance;
+	if (depth >= MAX_DEPTH || CurveTessellation::IsFlat(piece, flatness)) {
+		return index;
+	}
+
+	std::vector<glm::vec4> left, right;
+	CurveTessellation::SplitBezier(piece, 0.5f, left, right);
+	float mid = 0.5f * (t0 + t1);
+	int leftChild = BuildNode(span, left, t0, mid, tolerance, depth + 1);
+	int rightChild = BuildNode(span, right, mid, t1, tolerance, depth + 1);
+	m_nodes[index].children[0] = leftChild;
+	m_nodes[index].children[1] = rightChild;
+	return index;
+}
+
+void CurveProjector::Refine(const Span& span, const glm::vec3& p, float t0, float t1, float& bestT, float& bestDistance2) const {
+	auto test = [&](float t) {
+		glm::vec3 d = span.Evaluate(t) - p;
+		float distance2 = glm::dot(d, d);
+		if (distance2 < bestDistance2) {
+			bestDistance2 = distance2;
+			bestT = t;
+		}
+	};
+
+	// start from the projection onto the chord of the piece
+	glm::vec3 a = span.Evaluate(t0);
+	glm::vec3 b = span.Evaluate(t1);
+	glm::vec3 chord = b - a;
+	float chordLength2 = glm::dot(chord, chord);
+	float s = chordLength2 > 0.f ? glm::clamp(glm::dot(p - a, chord) / chordLength2, 0.f, 1.f) : 0.5f;
+	float t = glm::mix(t0, t1, s);
+
+	// Newton on g(t) = C'(t) . (C(t) - p), g'(t) = C''(t) . (C(t) - p) + |C'(t)|^2
+	for (int i = 0; i < NEWTON_ITERATIONS; ++i) {
+		glm::vec3 c, c1, c2;
+		span.Evaluate(t, c, c1, c2);
+		glm::vec3 d = c - p;
+		float g = glm::dot(c1, d);
+		float dg = glm::dot(c2, d) + glm::dot(c1, c1);
+		if (dg <= 0.f) {
+			break;
+		}
+		float next = glm::clamp(t - g / dg, t0, t1);
+		if (std::abs(next - t) < CurveTessellation::EPSILON * (t1 - t0)) {
+			t = next;
+			break;
+		}
+		t = next;
+	}
+
+	test(t);
+	test(t0);
+	test(t1);
+}
+
+CurveProjection CurveProjector::Project(const glm::vec3& p) const {
+	CurveProjection result;
+	if (IsEmpty()) {
+		return result;
+	}
+
+	// the end points of the spans give the first upper bound
+	float bestDistance2 = std::numeric_limits<float>::max();
+	float bestT = 0;
+	int bestSpan = 0;
+	for (int i = 0; i < m_spans.size(); ++i) {
+		for (float t : { 0.f, 1.f }) {
+			glm::vec3 d = glm::vec3(BezierAlgorithms::Dehomogenize(t == 0.f ? m_spans[i].points.front() : m_spans[i].points.back())) - p;
+			if (glm::dot(d, d) < bestDistance2) {
+				bestDistance2 = glm::dot(d, d);
+				bestT = t;
+				bestSpan = i;
+			}
+		}
+	}
+
+	// the curve is inside the bounding box of the control points of every piece
+	std::vector<int> stack(m_roots.rbegin(), m_roots.rend());
+	while (!stack.empty()) {
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		if (BoxDistance2(p, node.min, node.max) > bestDistance2) {
+			continue;
+		}
+		if (node.children[0] < 0) {
+			float t = bestT;
+			float distance2 = bestDistance2;
+			Refine(m_spans[node.span], p, node.t0, node.t1, t, distance2);
+			if (distance2 < bestDistance2) {
+				bestDistance2 = distance2;
+				bestT = t;
+				bestSpan = node.span;
+			}
+			continue;
+		}
+		// visit the nearer child first
+		const Node& left = m_nodes[node.children[0]];
+		const Node& right = m_nodes[node.children[1]];
+		if (BoxDistance2(p, left.min, left.max) < BoxDistance2(p, right.min, right.max)) {
+			stack.push_back(node.children[1]);
+			stack.push_back(node.children[0]);
+		}
+		else {
+			stack.push_back(node.children[0]);
+			stack.push_back(node.children[1]);
+		}
+	}
+
+	const Span& span = m_spans[bestSpan];
+	result.t = glm::mix(span.start, span.end, bestT);
+	result.point = span.Evaluate(bestT);
+	result.distance = glm::length(result.point - p);
+	return result;
+}
+
+void CurveProjector::ProjectRange(const glm::vec3* points, size_t count, CurveProjection* out) const {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = Project(points[i]);
+	}
+}
+
+void CurveProjector::Project(const glm::vec3* points, size_t count, CurveProjection* out, int threadCount) const {
+	if (threadCount <= 0) {
+		threadCount = glm::max((int)std::thread::hardware_concurrency(), 1);
+	}
+	threadCount = glm::min(threadCount, (int)(count / MIN_POINTS_PER_THREAD));
+	if (threadCount <= 1) {
+		ProjectRange(points, count, out);
+		return;
+	}
+
+	// the calling thread processes the last chunk
+	size_t chunk = (count + threadCount - 1) / threadCount;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadCount - 1; ++i) {
+		threads.emplace_back(&CurveProjector::ProjectRange, this, points + i * chunk, chunk, out + i * chunk);
+	}
+	size_t first = (threadCount - 1) * chunk;
+	ProjectRange(points + first, count - first, out + first);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+std::vector<CurveProjection> CurveProjector::Project(const std::vector<glm::vec3>& points, int threadCount) const {
+	std::vector<CurveProjection> result(points.size());
+	Project(points.data(), points.size(), result.data(), threadCount);
+	return result;
+}
\ No newline at end of file
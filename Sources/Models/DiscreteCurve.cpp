@@ -2,16 +2,116 @@
 
 DiscreteCurve::DiscreteCurve(DiscreteCurveParams params) : ModelBase(DISCRETECURVE2MODELBASE) {
 	m_type = MODEL_TYPE_DISCRETECURVE;
+	SetLevelOfDetail(params.levelOfDetail, params.lodPixelError);
+	SetColormap(params.colormap);
 	m_ctrlPoints = {
 		glm::vec4{0,0,0,1},
 		glm::vec4{1,0,0,1},
 		glm::vec4{0,1,0,1},
 	};
 	SetCtrlPointsSSBO();
+	if (params.streamHistory > 0) {
+		BeginStream(params.streamHistory);
+	}
 }
 DiscreteCurve::~DiscreteCurve() {
+	ReleaseRing();
 	glDeleteBuffers(1, &m_ctrlPointsSSBOID);
 	m_ctrlPointsSSBOID = 0;
+	glDeleteBuffers(1, &m_lodIndexBufferID);
+	m_lodIndexBufferID = 0;
+	glDeleteVertexArrays(1, &m_lodVAOID);
+	m_lodVAOID = 0;
+	glDeleteBuffers(1, &m_scalarsSSBOID);
+	m_scalarsSSBOID = 0;
+}
+
+void DiscreteCurve::WriteLodIndexBuffer() {
+	const std::vector<GLuint>& indices = GetSimplifier().GetIndices();
+	m_lodIndexDirty = false;
+	if (m_lodVAOID == 0) {
+		// no vertex attributes, the shader reads the point of gl_VertexID from the SSBO
+		glCreateBuffers(1, &m_lodIndexBufferID);
+		glCreateVertexArrays(1, &m_lodVAOID);
+		glVertexArrayElementBuffer(m_lodVAOID, m_lodIndexBufferID);
+	}
+	if (indices.empty()) {
+		return;
+	}
+	if (indices.size() > m_lodIndexCapacity) {
+		m_lodIndexCapacity = indices.size();
+		glNamedBufferData(m_lodIndexBufferID,
+			indices.size() * sizeof(GLuint),
+			indices.data(),
+			GL_STATIC_DRAW);
+	}
+	else {
+		glNamedBufferSubData(m_lodIndexBufferID,
+			0,
+			indices.size() * sizeof(GLuint),
+			indices.data());
+	}
+}
+
+void DiscreteCurve::WriteScalarsSSBO() {
+	const PolylineGeometry& geometry = GetGeometry();
+	const std::vector<float>& values = m_colormap == CurveColormap::Torsion ? geometry.GetTorsions() : geometry.GetCurvatures();
+	m_colormapDirty = false;
+	if (m_scalarsSSBOID == 0) {
+		glCreateBuffers(1, &m_scalarsSSBOID);
+	}
+	if (values.empty()) {
+		return;
+	}
+	auto range = std::minmax_element(values.begin(), values.end());
+	m_colormapRange = glm::vec2(*range.first, *range.second);
+	if (values.size() > m_scalarsCapacity) {
+		m_scalarsCapacity = values.size();
+		glNamedBufferData(m_scalarsSSBOID,
+			values.size() * sizeof(float),
+			values.data(),
+			GL_STATIC_DRAW);
+	}
+	else {
+		glNamedBufferSubData(m_scalarsSSBOID,
+			0,
+			values.size() * sizeof(float),
+			values.data());
+	}
+}
+
+float DiscreteCurve::GetPixelsPerUnit(RenderParams* p) const {
+	// bounding sphere of the transformed points
+	glm::mat4 transform = m_applyTransforms ? GetTransform() : glm::identity<glm::mat4>();
+	float scale = glm::max(glm::length(glm::vec3(transform[0])), glm::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+	glm::vec3 center = transform * glm::vec4(0.5f * (m_simplifier.GetMin() + m_simplifier.GetMax()), 1);
+	float radius = scale * 0.5f * glm::length(m_simplifier.GetMax() - m_simplifier.GetMin());
+
+	glm::vec3 view = center - p->cameraPos;
+	float distance = glm::length(view);
+	if (distance <= radius || scale <= 0.f) {
+		return 0.f;
+	}
+	// a unit step across the view direction at the closest point of the sphere, the error is largest there
+	glm::vec3 dir = view / distance;
+	glm::vec3 side = glm::normalize(glm::cross(dir, std::abs(dir.y) < 0.99f ? glm::vec3(0, 1, 0) : glm::vec3(1, 0, 0)));
+	glm::vec3 nearest = p->cameraPos + (distance - radius) * dir;
+	glm::vec4 a = p->viewProj * glm::vec4(nearest, 1);
+	glm::vec4 b = p->viewProj * glm::vec4(nearest + side, 1);
+	if (a.w <= 0.f || b.w <= 0.f) {
+		return 0.f;
+	}
+	glm::vec2 pixels = (glm::vec2(b) / b.w - glm::vec2(a) / a.w) * 0.5f * glm::vec2(p->windowSize);
+	// tolerances are measured on the untransformed points
+	return glm::length(pixels) * scale;
+}
+
+void DiscreteCurve::SetCurveUniforms(GLuint progID) const {
+	// static points are transformed when they are written, streamed points in the shader
+	glm::mat4 world = m_streaming && m_applyTransforms ? GetTransform() : glm::identity<glm::mat4>();
+	glUniformMatrix4fv(ul(progID, "transformData.world"), 1, GL_FALSE, glm::value_ptr(world));
+	glUniform1i(ul(progID, "discreteCurveData.ringStart"), m_streaming ? int(m_streamStart % m_ringCapacity) : 0);
+	glUniform1i(ul(progID, "discreteCurveData.ringCapacity"), m_streaming ? m_ringCapacity : glm::max(GetCtrlPointCount(), 1));
 }
 
 void DiscreteCurve::Render(RenderParams* p) {
@@ -19,8 +119,19 @@ void DiscreteCurve::Render(RenderParams* p) {
 		return;
 	}
 
+	// -- Append the points of the producer thread --
+	if (m_streaming) {
+		m_streamQueue->Consume([this](const glm::vec4* points, size_t count) {
+			StreamPoints(points, count);
+		});
+	}
+
 	// -- Check if the surface can be rendered --
-	if (GetCtrlPoints().size() < 2) {
+	if (GetCtrlPointCount() < 2) {
+		if (m_streaming) {
+			// the stream has not delivered enough points yet
+			return;
+		}
 		Log::errorToConsole("DiscreteCurve \"", GetName().c_str(), "\" has too few control points");
 		SetShow(false);
 		return;
@@ -47,8 +158,29 @@ void DiscreteCurve::Render(RenderParams* p) {
 		transformsReset = true;
 	}
 
-	if (transformsReset || m_ctrlPointsDirty) {
+	if (!m_streaming && (transformsReset || m_ctrlPointsDirty)) {
 		WriteCtrlPointsSSBO();
+		m_ctrlPointsDirty = false;
+	}
+
+	// -- Select the level of detail --
+	m_lodLevel = 0;
+	if (m_levelOfDetail && !m_streaming) {
+		// GetSimplifier may have rebuilt the levels outside of rendering, the element buffer follows them separately
+		GetSimplifier();
+		if (m_lodIndexDirty) {
+			WriteLodIndexBuffer();
+		}
+		float pixelsPerUnit = GetPixelsPerUnit(p);
+		if (pixelsPerUnit > 0.f) {
+			m_lodLevel = m_simplifier.SelectLevel(m_lodPixelError / pixelsPerUnit);
+		}
+	}
+
+	// -- Update the colormap values if needed --
+	bool colormap = m_colormap != CurveColormap::None && !m_streaming;
+	if (colormap && (m_geometryDirty || m_colormapDirty)) {
+		WriteScalarsSSBO();
 	}
 
 	// -- Set render options --
@@ -63,14 +195,31 @@ void DiscreteCurve::Render(RenderParams* p) {
 	// -- Set shader input data --
 	// Discrete curve module
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, GetCtrlPointsSSBO());
+	SetCurveUniforms(progID);
 	// Camera module
 	glUniform3fv(ul(progID, "cameraData.eye"), 1, glm::value_ptr(p->cameraPos));
 	glUniformMatrix4fv(ul(progID, "cameraData.viewProj"), 1, GL_FALSE, glm::value_ptr(p->viewProj));
 	// Color module
 	glUniform3fv(ul(progID, "colorData.color"), 1, glm::value_ptr(GetColor()));
+	// Colormap module
+	glUniform1i(ul(progID, "colormapData.enabled"), colormap);
+	if (colormap) {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, m_scalarsSSBOID);
+		glUniform1f(ul(progID, "colormapData.minValue"), m_colormapRange.x);
+		glUniform1f(ul(progID, "colormapData.maxValue"), m_colormapRange.y);
+	}
 
 	// -- Draw call --
-	glDrawArrays(m_drawMode, 0, GetCtrlPointCount());
+	if (m_lodLevel > 0) {
+		// with indexed drawing gl_VertexID is the index, the levels select points of the same SSBO
+		const PolylineSimplifier::Level& level = m_simplifier.GetLevel(m_lodLevel);
+		glBindVertexArray(m_lodVAOID);
+		glDrawElements(m_drawMode, level.count, GL_UNSIGNED_INT, (void*)(level.first * sizeof(GLuint)));
+		glBindVertexArray(0);
+	}
+	else {
+		glDrawArrays(m_drawMode, 0, GetCtrlPointCount());
+	}
 
 	// -- Restore initial OGL state --
 	glLineWidth(lineWidth);
@@ -80,6 +229,11 @@ void DiscreteCurve::Render(RenderParams* p) {
 	if (p->selected) {
 		RenderSelection(p);
 	}
+
+	// -- Protect the ring slots read by this frame --
+	if (m_streaming) {
+		FenceRing();
+	}
 }
 void DiscreteCurve::RenderSelection(RenderParams* p) {
 	// -- Activate shader --
@@ -94,11 +248,14 @@ void DiscreteCurve::RenderSelection(RenderParams* p) {
 	// -- Set shader input data --
 	// Discrete curve module
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, GetCtrlPointsSSBO());
+	SetCurveUniforms(progID);
 	// Camera module
 	glUniform3fv(ul(progID, "cameraData.eye"), 1, glm::value_ptr(p->cameraPos));
 	glUniformMatrix4fv(ul(progID, "cameraData.viewProj"), 1, GL_FALSE, glm::value_ptr(p->viewProj));
 	// Color module
 	glUniform3fv(ul(progID, "colorData.color"), 1, glm::value_ptr(p->selectionColor));
+	// Colormap module
+	glUniform1i(ul(progID, "colormapData.enabled"), 0);
 
 	// -- Draw call --
 	glDrawArrays(GL_POINTS, 0, GetCtrlPointCount());
@@ -110,6 +267,50 @@ void DiscreteCurve::RenderSelection(RenderParams* p) {
 void DiscreteCurve::RenderGUI(std::vector<ModelBase*>* models) {
 	ImGui::Text("Discrete-curve specific options");
 
+	// streaming
+	if (IsStreaming()) {
+		ImGui::Text("Streaming, %d of %d points of history", GetCtrlPointCount(), GetHistorySize());
+		ImGui::Text("Queued: %d, dropped: %d", (int)m_streamQueue->GetSize(), (int)m_streamQueue->GetDroppedCount());
+		if (ImGui::Button("End stream")) {
+			EndStream();
+		}
+		ImGui::Spacing();
+		ImGui::Separator();
+		ImGui::Spacing();
+		// the control point list and the queries would copy the whole history every frame
+		return;
+	}
+	ImGui::DragInt("History (points)", &m_streamHistoryGUI, 100.f, 2, 1 << 26);
+	ImGui::SameLine();
+	if (ImGui::Button("Begin stream")) {
+		BeginStream(m_streamHistoryGUI);
+		return;
+	}
+
+	ImGui::Text("Length: %f", GetArcLengthTable().GetLength());
+
+	// colormap
+	int colormap = (int)GetColormap();
+	if (ImGui::Combo("Colormap", &colormap, "None\0Curvature\0Torsion\0")) {
+		SetColormap((CurveColormap)colormap);
+	}
+	if (GetColormap() != CurveColormap::None) {
+		ImGui::Text("Range: %f ... %f", GetColormapRange().x, GetColormapRange().y);
+	}
+
+	// level of detail
+	bool levelOfDetail = GetLevelOfDetail();
+	float pixelError = GetLodPixelError();
+	bool lodChanged = ImGui::Checkbox("Level of detail", &levelOfDetail);
+	lodChanged |= ImGui::DragFloat("LOD error (pixels)", &pixelError, 0.05f, 0.f, 20.f, "%.2f");
+	if (lodChanged) {
+		SetLevelOfDetail(levelOfDetail, pixelError);
+	}
+	if (GetLevelOfDetail() && !m_simplifier.IsEmpty()) {
+		ImGui::Text("Level %d of %d, %d of %d points", m_lodLevel, m_simplifier.GetLevelCount() - 1,
+			m_simplifier.GetLevel(m_lodLevel).count, GetCtrlPointCount());
+	}
+
 	DiscreteCurve* d = this;
 
 	// ctrl points
@@ -156,4 +357,200 @@ void DiscreteCurve::RenderGUI(std::vector<ModelBase*>* models) {
 	ImGui::Spacing();
 	ImGui::Separator();
 	ImGui::Spacing();
+}
+
+bool DiscreteCurve::BeginStream(int historySize, int queueCapacity) {
+	if (historySize < 2) {
+		Log::errorToConsole("DiscreteCurve::BeginStream the history needs at least 2 points");
+		return false;
+	}
+	std::vector<glm::vec4> points = GetCtrlPoints();
+	ReleaseRing();
+
+	// twice the history, so the points of a whole window can be appended while a frame is in flight
+	int capacity = 2 * historySize;
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	glCreateBuffers(1, &m_ringSSBOID);
+	glNamedBufferStorage(m_ringSSBOID, capacity * sizeof(glm::vec4), nullptr, flags);
+	m_ringMapped = (glm::vec4*)glMapNamedBufferRange(m_ringSSBOID, 0, capacity * sizeof(glm::vec4), flags);
+	if (m_ringMapped == nullptr) {
+		Log::errorToConsole("DiscreteCurve::BeginStream the ring buffer could not be mapped");
+		glDeleteBuffers(1, &m_ringSSBOID);
+		m_ringSSBOID = 0;
+		// keep the points as they were
+		SetCtrlPoints(points);
+		return false;
+	}
+	m_ringCapacity = capacity;
+	m_historySize = historySize;
+	m_ringPoints.assign(capacity, glm::vec4(0));
+	m_streamStart = 0;
+	m_streamEnd = 0;
+	m_streamQueue = std::make_unique<PointQueue>(glm::max(queueCapacity, 2));
+	m_streaming = true;
+	m_streamPointsDirty = true;
+	m_arcLengthDirty = true;
+	m_lodDirty = true;
+	m_geometryDirty = true;
+	m_lodLevel = 0;
+	StreamPoints(points.data(), points.size());
+	return true;
+}
+
+void DiscreteCurve::EndStream() {
+	if (!m_streaming) {
+		return;
+	}
+	std::vector<glm::vec4> points = GetCtrlPoints();
+	ReleaseRing();
+	m_streamQueue.reset();
+	SetCtrlPoints(points);
+}
+
+void DiscreteCurve::StreamPoints(const glm::vec4* points, size_t count) {
+	if (!m_streaming) {
+		m_ctrlPoints.insert(m_ctrlPoints.end(), points, points + count);
+		m_ctrlPointsDirty = true;
+		m_arcLengthDirty = true;
+		m_lodDirty = true;
+		m_geometryDirty = true;
+		return;
+	}
+	if (count == 0) {
+		return;
+	}
+	// only the last historySize points can stay in the window
+	size_t history = m_historySize;
+	if (count > history) {
+		m_streamEnd += count - history;
+		m_streamStart = m_streamEnd;
+		points += count - history;
+		count = history;
+	}
+	WaitForRing(m_streamEnd + count - 1);
+
+	// at most two contiguous runs of slots, written into the mapped buffer and its CPU copy
+	size_t written = 0;
+	while (written < count) {
+		size_t slot = (m_streamEnd + written) % m_ringCapacity;
+		size_t run = std::min(count - written, m_ringCapacity - slot);
+		std::copy(points + written, points + written + run, m_ringMapped + slot);
+		std::copy(points + written, points + written + run, m_ringPoints.data() + slot);
+		written += run;
+	}
+	m_streamEnd += count;
+	if (m_streamEnd - m_streamStart > history) {
+		m_streamStart = m_streamEnd - history;
+	}
+
+	m_streamPointsDirty = true;
+	m_arcLengthDirty = true;
+	m_lodDirty = true;
+	m_geometryDirty = true;
+}
+
+void DiscreteCurve::WaitForRing(size_t lastPoint) {
+	// point s overwrites point s - m_ringCapacity, frames whose window started at or before that must be done
+	while (!m_ringFences.empty() && m_ringFences.front().second + m_ringCapacity <= lastPoint) {
+		GLsync fence = m_ringFences.front().first;
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		while (result == GL_TIMEOUT_EXPIRED) {
+			result = glClientWaitSync(fence, 0, 1000000000);
+		}
+		if (result == GL_WAIT_FAILED) {
+			Log::errorToConsole("DiscreteCurve::WaitForRing waiting for a fence failed");
+		}
+		glDeleteSync(fence);
+		m_ringFences.pop_front();
+	}
+}
+
+void DiscreteCurve::FenceRing() {
+	// drop the fences of the finished frames without waiting
+	while (!m_ringFences.empty()) {
+		GLenum result = glClientWaitSync(m_ringFences.front().first, 0, 0);
+		if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+			break;
+		}
+		glDeleteSync(m_ringFences.front().first);
+		m_ringFences.pop_front();
+	}
+	m_ringFences.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_streamStart });
+}
+
+void DiscreteCurve::ReleaseRing() {
+	for (auto& fence : m_ringFences) {
+		glDeleteSync(fence.first);
+	}
+	m_ringFences.clear();
+	if (m_ringSSBOID != 0) {
+		glUnmapNamedBuffer(m_ringSSBOID);
+		glDeleteBuffers(1, &m_ringSSBOID);
+		m_ringSSBOID = 0;
+	}
+	m_ringMapped = nullptr;
+	m_ringPoints.clear();
+	m_ringPoints.shrink_to_fit();
+	m_ringCapacity = 0;
+	m_streamStart = 0;
+	m_streamEnd = 0;
+	m_streaming = false;
+}
+
+std::vector<glm::vec4> DiscreteCurve::GetCtrlPoints() const {
+	if (!m_streaming) {
+		return m_ctrlPoints;
+	}
+	std::vector<glm::vec4> points;
+	points.reserve(m_streamEnd - m_streamStart);
+	for (size_t s = m_streamStart; s < m_streamEnd; ++s) {
+		points.push_back(m_ringPoints[s % m_ringCapacity]);
+	}
+	return points;
+}
+
+void DiscreteCurve::SyncStreamedPoints() {
+	if (m_streaming && m_streamPointsDirty) {
+		m_ctrlPoints = GetCtrlPoints();
+		m_streamPointsDirty = false;
+	}
+}
+
+const PolylineGeometry& DiscreteCurve::GetGeometry() {
+	SyncStreamedPoints();
+	if (m_geometryDirty) {
+		m_geometry.Compute(m_ctrlPoints);
+		m_geometryDirty = false;
+		m_colormapDirty = true;
+	}
+	return m_geometry;
+}
+
+const PolylineSimplifier& DiscreteCurve::GetSimplifier() {
+	SyncStreamedPoints();
+	if (m_lodDirty) {
+		m_simplifier.Build(m_ctrlPoints);
+		m_lodDirty = false;
+		m_lodIndexDirty = true;
+	}
+	return m_simplifier;
+}
+
+ArcLengthTable& DiscreteCurve::GetArcLengthTable() {
+	SyncStreamedPoints();
+	if (m_arcLengthDirty) {
+		// cumulative chord lengths, parameter i is the i-th point
+		m_arcLengthTable.BuildPolyline(m_ctrlPoints);
+		m_arcLengthDirty = false;
+	}
+	return m_arcLengthTable;
+}
+glm::vec4 DiscreteCurve::GetPointAtLength(float s) {
+	if (GetCtrlPointCount() < 2) {
+		Log::errorToConsole("DiscreteCurve::GetPointAtLength too few control points");
+		return glm::vec4(0);
+	}
+	float t = GetArcLengthTable().GetParam(s);
+	int i = glm::clamp((int)t, 0, GetCtrlPointCount() - 2);
+	return glm::mix(m_ctrlPoints[i], m_ctrlPoints[i + 1], t - float(i));
 }
\ No newline at end of file
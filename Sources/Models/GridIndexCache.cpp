@@ -0,0 +1,45 @@
+#include "../../Headers/include_all.h"
+
+std::vector<GLuint> GridIndexCache::BuildIndices(glm::ivec2 division) {
+	std::vector<GLuint> indices;
+	if (division.x < 2 || division.y < 2) {
+		return indices;
+	}
+	indices.reserve(GetIndexCount(division));
+	for (int iv = 0; iv < division.y - 1; ++iv) {
+		for (int iu = 0; iu < division.x - 1; ++iu) {
+			GLuint i00 = iv * division.x + iu;
+			GLuint i10 = i00 + 1;
+			GLuint i01 = i00 + division.x;
+			GLuint i11 = i01 + 1;
+			// the same triangles as the earlier non-indexed vertex order
+			indices.insert(indices.end(), { i00, i01, i10 });
+			indices.insert(indices.end(), { i11, i10, i01 });
+		}
+	}
+	return indices;
+}
+
+GLuint GridIndexCache::Get(glm::ivec2 division) {
+	if (division.x < 2 || division.y < 2) {
+		Log::errorToConsole("GridIndexCache::Get division has to be at least 2");
+		return 0;
+	}
+	GLuint& buffer = m_buffers[{ division.x, division.y }];
+	if (buffer == 0) {
+		std::vector<GLuint> indices = BuildIndices(division);
+		glCreateBuffers(1, &buffer);
+		glNamedBufferData(buffer,
+			indices.size() * sizeof(GLuint),
+			indices.data(),
+			GL_STATIC_DRAW);
+	}
+	return buffer;
+}
+
+void GridIndexCache::Clean() {
+	for (auto& entry : m_buffers) {
+		glDeleteBuffers(1, &entry.second);
+	}
+	m_buffers.clear();
+}
@@ -0,0 +1,24 @@
+#include "../../Headers/include_all.h"
+
+PointQueue::PointQueue(size_t capacity) {
+	size_t size = 2;
+	while (size < capacity) {
+		size *= 2;
+	}
+	m_points.resize(size);
+	m_mask = size - 1;
+}
+
+size_t PointQueue::Push(const glm::vec4* points, size_t count) {
+	size_t head = m_head.load(std::memory_order_relaxed);
+	size_t free = m_points.size() - (head - m_tail.load(std::memory_order_acquire));
+	size_t pushed = std::min(count, free);
+	for (size_t i = 0; i < pushed; ++i) {
+		m_points[(head + i) & m_mask] = points[i];
+	}
+	m_head.store(head + pushed, std::memory_order_release);
+	if (pushed < count) {
+		m_dropped.fetch_add(count - pushed, std::memory_order_relaxed);
+	}
+	return pushed;
+}
@@ -0,0 +1,392 @@
+#include "../../Headers/include_all.h"
+
+// calls f(first, count) on consecutive chunks of 0 .. count - 1, the calling thread processes the last chunk
+template <typename F>
+static void ParallelFor(size_t count, int threadCount, size_t minPerThread, F f) {
+	if (threadCount <= 0) {
+		threadCount = glm::max((int)std::thread::hardware_concurrency(), 1);
+	}
+	threadCount = glm::min(threadCount, (int)(count / minPerThread));
+	if (threadCount <= 1) {
+		f(0, count);
+		return;
+	}
+
+	// chunks of whole AVX lanes
+	size_t chunk = ((count + threadCount - 1) / threadCount + 7) & ~size_t(7);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadCount - 1; ++i) {
+		threads.emplace_back(f, i * chunk, chunk);
+	}
+	size_t first = (threadCount - 1) * chunk;
+	f(first, count - first);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+static glm::vec3 SafeNormalize(const glm::vec3& v) {
+	float length = glm::length(v);
+	return length > 0.f ? v / length : glm::vec3(0);
+}
+
+size_t PolylineGeometry::FramesScalar(size_t first, size_t count) {
+	for (size_t k = first; k < first + count; ++k) {
+		glm::vec3 in = m_points[k] - m_points[k - 1];
+		glm::vec3 out = m_points[k + 1] - m_points[k];
+		float lengthIn = glm::length(in);
+		float lengthOut = glm::length(out);
+
+		glm::vec3 tangent = SafeNormalize(SafeNormalize(in) + SafeNormalize(out));
+		glm::vec3 cross = glm::cross(in, out);
+		float lengthCross = glm::length(cross);
+		glm::vec3 binormal = lengthCross > PARALLEL_SINE * lengthIn * lengthOut ? cross / lengthCross : glm::vec3(0);
+		float denominator = lengthIn * lengthOut * glm::length(in + out);
+
+		m_tangents.Set(k, tangent);
+		m_binormals.Set(k, binormal);
+		m_normals.Set(k, glm::cross(binormal, tangent));
+		m_curvatures[k] = denominator > 0.f ? 2.f * lengthCross / denominator : 0.f;
+	}
+	return count;
+}
+
+size_t PolylineGeometry::TorsionScalar(size_t first, size_t count) {
+	for (size_t k = first; k < first + count; ++k) {
+		float ds = glm::length(m_points[k] - m_points[k - 1]) + glm::length(m_points[k + 1] - m_points[k]);
+		float dB = glm::dot(m_binormals[k + 1] - m_binormals[k - 1], m_normals[k]);
+		m_torsions[k] = ds > 0.f ? -dB / ds : 0.f;
+	}
+	return count;
+}
+
+#ifdef SIMD_SSE
+// 1 / x where x > 0, 0 elsewhere
+static inline __m128 SafeInverseSSE(__m128 x) {
+	return _mm_and_ps(_mm_cmpgt_ps(x, _mm_setzero_ps()), _mm_div_ps(_mm_set1_ps(1.f), x));
+}
+static inline __m128 DotSSE(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz) {
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+
+size_t PolylineGeometry::FramesSSE(size_t first, size_t count) {
+	const __m128 parallelSine = _mm_set1_ps(PARALLEL_SINE);
+	const __m128 two = _mm_set1_ps(2.f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const size_t k = first + i;
+		const __m128 px = _mm_loadu_ps(&m_points.x[k]);
+		const __m128 py = _mm_loadu_ps(&m_points.y[k]);
+		const __m128 pz = _mm_loadu_ps(&m_points.z[k]);
+		const __m128 inX = _mm_sub_ps(px, _mm_loadu_ps(&m_points.x[k - 1]));
+		const __m128 inY = _mm_sub_ps(py, _mm_loadu_ps(&m_points.y[k - 1]));
+		const __m128 inZ = _mm_sub_ps(pz, _mm_loadu_ps(&m_points.z[k - 1]));
+		const __m128 outX = _mm_sub_ps(_mm_loadu_ps(&m_points.x[k + 1]), px);
+		const __m128 outY = _mm_sub_ps(_mm_loadu_ps(&m_points.y[k + 1]), py);
+		const __m128 outZ = _mm_sub_ps(_mm_loadu_ps(&m_points.z[k + 1]), pz);
+		const __m128 lengthIn = _mm_sqrt_ps(DotSSE(inX, inY, inZ, inX, inY, inZ));
+		const __m128 lengthOut = _mm_sqrt_ps(DotSSE(outX, outY, outZ, outX, outY, outZ));
+
+		// tangent
+		const __m128 inverseIn = SafeInverseSSE(lengthIn);
+		const __m128 inverseOut = SafeInverseSSE(lengthOut);
+		__m128 tx = _mm_add_ps(_mm_mul_ps(inX, inverseIn), _mm_mul_ps(outX, inverseOut));
+		__m128 ty = _mm_add_ps(_mm_mul_ps(inY, inverseIn), _mm_mul_ps(outY, inverseOut));
+		__m128 tz = _mm_add_ps(_mm_mul_ps(inZ, inverseIn), _mm_mul_ps(outZ, inverseOut));
+		const __m128 inverseT = SafeInverseSSE(_mm_sqrt_ps(DotSSE(tx, ty, tz, tx, ty, tz)));
+		tx = _mm_mul_ps(tx, inverseT);
+		ty = _mm_mul_ps(ty, inverseT);
+		tz = _mm_mul_ps(tz, inverseT);
+
+		// binormal, 0 where the edges are parallel
+		const __m128 cx = _mm_sub_ps(_mm_mul_ps(inY, outZ), _mm_mul_ps(inZ, outY));
+		const __m128 cy = _mm_sub_ps(_mm_mul_ps(inZ, outX), _mm_mul_ps(inX, outZ));
+		const __m128 cz = _mm_sub_ps(_mm_mul_ps(inX, outY), _mm_mul_ps(inY, outX));
+		const __m128 lengthCross = _mm_sqrt_ps(DotSSE(cx, cy, cz, cx, cy, cz));
+		const __m128 lengthProduct = _mm_mul_ps(lengthIn, lengthOut);
+		const __m128 curved = _mm_cmpgt_ps(lengthCross, _mm_mul_ps(parallelSine, lengthProduct));
+		const __m128 inverseCross = _mm_and_ps(curved, SafeInverseSSE(lengthCross));
+		const __m128 bx = _mm_mul_ps(cx, inverseCross);
+		const __m128 by = _mm_mul_ps(cy, inverseCross);
+		const __m128 bz = _mm_mul_ps(cz, inverseCross);
+
+		// normal = binormal x tangent
+		const __m128 nx = _mm_sub_ps(_mm_mul_ps(by, tz), _mm_mul_ps(bz, ty));
+		const __m128 ny = _mm_sub_ps(_mm_mul_ps(bz, tx), _mm_mul_ps(bx, tz));
+		const __m128 nz = _mm_sub_ps(_mm_mul_ps(bx, ty), _mm_mul_ps(by, tx));
+
+		// curvature
+		const __m128 sx = _mm_add_ps(inX, outX);
+		const __m128 sy = _mm_add_ps(inY, outY);
+		const __m128 sz = _mm_add_ps(inZ, outZ);
+		const __m128 chord = _mm_sqrt_ps(DotSSE(sx, sy, sz, sx, sy, sz));
+		const __m128 curvature = _mm_mul_ps(_mm_mul_ps(two, lengthCross), SafeInverseSSE(_mm_mul_ps(lengthProduct, chord)));
+
+		_mm_storeu_ps(&m_tangents.x[k], tx);
+		_mm_storeu_ps(&m_tangents.y[k], ty);
+		_mm_storeu_ps(&m_tangents.z[k], tz);
+		_mm_storeu_ps(&m_binormals.x[k], bx);
+		_mm_storeu_ps(&m_binormals.y[k], by);
+		_mm_storeu_ps(&m_binormals.z[k], bz);
+		_mm_storeu_ps(&m_normals.x[k], nx);
+		_mm_storeu_ps(&m_normals.y[k], ny);
+		_mm_storeu_ps(&m_normals.z[k], nz);
+		_mm_storeu_ps(&m_curvatures[k], curvature);
+	}
+	return i;
+}
+
+size_t PolylineGeometry::TorsionSSE(size_t first, size_t count) {
+	const __m128 minusOne = _mm_set1_ps(-1.f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const size_t k = first + i;
+		const __m128 px = _mm_loadu_ps(&m_points.x[k]);
+		const __m128 py = _mm_loadu_ps(&m_points.y[k]);
+		const __m128 pz = _mm_loadu_ps(&m_points.z[k]);
+		const __m128 inX = _mm_sub_ps(px, _mm_loadu_ps(&m_points.x[k - 1]));
+		const __m128 inY = _mm_sub_ps(py, _mm_loadu_ps(&m_points.y[k - 1]));
+		const __m128 inZ = _mm_sub_ps(pz, _mm_loadu_ps(&m_points.z[k - 1]));
+		const __m128 outX = _mm_sub_ps(_mm_loadu_ps(&m_points.x[k + 1]), px);
+		const __m128 outY = _mm_sub_ps(_mm_loadu_ps(&m_points.y[k + 1]), py);
+		const __m128 outZ = _mm_sub_ps(_mm_loadu_ps(&m_points.z[k + 1]), pz);
+		const __m128 ds = _mm_add_ps(_mm_sqrt_ps(DotSSE(inX, inY, inZ, inX, inY, inZ)),
+			_mm_sqrt_ps(DotSSE(outX, outY, outZ, outX, outY, outZ)));
+
+		const __m128 dbx = _mm_sub_ps(_mm_loadu_ps(&m_binormals.x[k + 1]), _mm_loadu_ps(&m_binormals.x[k - 1]));
+		const __m128 dby = _mm_sub_ps(_mm_loadu_ps(&m_binormals.y[k + 1]), _mm_loadu_ps(&m_binormals.y[k - 1]));
+		const __m128 dbz = _mm_sub_ps(_mm_loadu_ps(&m_binormals.z[k + 1]), _mm_loadu_ps(&m_binormals.z[k - 1]));
+		const __m128 dB = DotSSE(dbx, dby, dbz,
+			_mm_loadu_ps(&m_normals.x[k]), _mm_loadu_ps(&m_normals.y[k]), _mm_loadu_ps(&m_normals.z[k]));
+		_mm_storeu_ps(&m_torsions[k], _mm_mul_ps(_mm_mul_ps(minusOne, dB), SafeInverseSSE(ds)));
+	}
+	return i;
+}
+#endif
+
+#ifdef SIMD_AVX
+// 1 / x where x > 0, 0 elsewhere
+static inline __m256 SafeInverseAVX(__m256 x) {
+	return _mm256_and_ps(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ), _mm256_div_ps(_mm256_set1_ps(1.f), x));
+}
+static inline __m256 DotAVX(__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz) {
+	return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+}
+
+size_t PolylineGeometry::FramesAVX(size_t first, size_t count) {
+	const __m256 parallelSine = _mm256_set1_ps(PARALLEL_SINE);
+	const __m256 two = _mm256_set1_ps(2.f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const size_t k = first + i;
+		const __m256 px = _mm256_loadu_ps(&m_points.x[k]);
+		const __m256 py = _mm256_loadu_ps(&m_points.y[k]);
+		const __m256 pz = _mm256_loadu_ps(&m_points.z[k]);
+		const __m256 inX = _mm256_sub_ps(px, _mm256_loadu_ps(&m_points.x[k - 1]));
+		const __m256 inY = _mm256_sub_ps(py, _mm256_loadu_ps(&m_points.y[k - 1]));
+		const __m256 inZ = _mm256_sub_ps(pz, _mm256_loadu_ps(&m_points.z[k - 1]));
+		const __m256 outX = _mm256_sub_ps(_mm256_loadu_ps(&m_points.x[k + 1]), px);
+		const __m256 outY = _mm256_sub_ps(_mm256_loadu_ps(&m_points.y[k + 1]), py);
+		const __m256 outZ = _mm256_sub_ps(_mm256_loadu_ps(&m_points.z[k + 1]), pz);
+		const __m256 lengthIn = _mm256_sqrt_ps(DotAVX(inX, inY, inZ, inX, inY, inZ));
+		const __m256 lengthOut = _mm256_sqrt_ps(DotAVX(outX, outY, outZ, outX, outY, outZ));
+
+		// tangent
+		const __m256 inverseIn = SafeInverseAVX(lengthIn);
+		const __m256 inverseOut = SafeInverseAVX(lengthOut);
+		__m256 tx = _mm256_add_ps(_mm256_mul_ps(inX, inverseIn), _mm256_mul_ps(outX, inverseOut));
+		__m256 ty = _mm256_add_ps(_mm256_mul_ps(inY, inverseIn), _mm256_mul_ps(outY, inverseOut));
+		__m256 tz = _mm256_add_ps(_mm256_mul_ps(inZ, inverseIn), _mm256_mul_ps(outZ, inverseOut));
+		const __m256 inverseT = SafeInverseAVX(_mm256_sqrt_ps(DotAVX(tx, ty, tz, tx, ty, tz)));
+		tx = _mm256_mul_ps(tx, inverseT);
+		ty = _mm256_mul_ps(ty, inverseT);
+		tz = _mm256_mul_ps(tz, inverseT);
+
+		// binormal, 0 where the edges are parallel
+		const __m256 cx = _mm256_sub_ps(_mm256_mul_ps(inY, outZ), _mm256_mul_ps(inZ, outY));
+		const __m256 cy = _mm256_sub_ps(_mm256_mul_ps(inZ, outX), _mm256_mul_ps(inX, outZ));
+		const __m256 cz = _mm256_sub_ps(_mm256_mul_ps(inX, outY), _mm256_mul_ps(inY, outX));
+		const __m256 lengthCross = _mm256_sqrt_ps(DotAVX(cx, cy, cz, cx, cy, cz));
+		const __m256 lengthProduct = _mm256_mul_ps(lengthIn, lengthOut);
+		const __m256 curved = _mm256_cmp_ps(lengthCross, _mm256_mul_ps(parallelSine, lengthProduct), _CMP_GT_OQ);
+		const __m256 inverseCross = _mm256_and_ps(curved, SafeInverseAVX(lengthCross));
+		const __m256 bx = _mm256_mul_ps(cx, inverseCross);
+		const __m256 by = _mm256_mul_ps(cy, inverseCross);
+		const __m256 bz = _mm256_mul_ps(cz, inverseCross);
+
+		// normal = binormal x tangent
+		const __m256 nx = _mm256_sub_ps(_mm256_mul_ps(by, tz), _mm256_mul_ps(bz, ty));
+		const __m256 ny = _mm256_sub_ps(_mm256_mul_ps(bz, tx), _mm256_mul_ps(bx, tz));
+		const __m256 nz = _mm256_sub_ps(_mm256_mul_ps(bx, ty), _mm256_mul_ps(by, tx));
+
+		// curvature
+		const __m256 sx = _mm256_add_ps(inX, outX);
+		const __m256 sy = _mm256_add_ps(inY, outY);
+		const __m256 sz = _mm256_add_ps(inZ, outZ);
+		const __m256 chord = _mm256_sqrt_ps(DotAVX(sx, sy, sz, sx, sy, sz));
+		const __m256 curvature = _mm256_mul_ps(_mm256_mul_ps(two, lengthCross), SafeInverseAVX(_mm256_mul_ps(lengthProduct, chord)));
+
+		_mm256_storeu_ps(&m_tangents.x[k], tx);
+		_mm256_storeu_ps(&m_tangents.y[k], ty);
+		_mm256_storeu_ps(&m_tangents.z[k], tz);
+		_mm256_storeu_ps(&m_binormals.x[k], bx);
+		_mm256_storeu_ps(&m_binormals.y[k], by);
+		_mm256_storeu_ps(&m_binormals.z[k], bz);
+		_mm256_storeu_ps(&m_normals.x[k], nx);
+		_mm256_storeu_ps(&m_normals.y[k], ny);
+		_mm256_storeu_ps(&m_normals.z[k], nz);
+		_mm256_storeu_ps(&m_curvatures[k], curvature);
+	}
+	return i;
+}
+
+size_t PolylineGeometry::TorsionAVX(size_t first, size_t count) {
+	const __m256 minusOne = _mm256_set1_ps(-1.f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const size_t k = first + i;
+		const __m256 px = _mm256_loadu_ps(&m_points.x[k]);
+		const __m256 py = _mm256_loadu_ps(&m_points.y[k]);
+		const __m256 pz = _mm256_loadu_ps(&m_points.z[k]);
+		const __m256 inX = _mm256_sub_ps(px, _mm256_loadu_ps(&m_points.x[k - 1]));
+		const __m256 inY = _mm256_sub_ps(py, _mm256_loadu_ps(&m_points.y[k - 1]));
+		const __m256 inZ = _mm256_sub_ps(pz, _mm256_loadu_ps(&m_points.z[k - 1]));
+		const __m256 outX = _mm256_sub_ps(_mm256_loadu_ps(&m_points.x[k + 1]), px);
+		const __m256 outY = _mm256_sub_ps(_mm256_loadu_ps(&m_points.y[k + 1]), py);
+		const __m256 outZ = _mm256_sub_ps(_mm256_loadu_ps(&m_points.z[k + 1]), pz);
+		const __m256 ds = _mm256_add_ps(_mm256_sqrt_ps(DotAVX(inX, inY, inZ, inX, inY, inZ)),
+			_mm256_sqrt_ps(DotAVX(outX, outY, outZ, outX, outY, outZ)));
+
+		const __m256 dbx = _mm256_sub_ps(_mm256_loadu_ps(&m_binormals.x[k + 1]), _mm256_loadu_ps(&m_binormals.x[k - 1]));
+		const __m256 dby = _mm256_sub_ps(_mm256_loadu_ps(&m_binormals.y[k + 1]), _mm256_loadu_ps(&m_binormals.y[k - 1]));
+		const __m256 dbz = _mm256_sub_ps(_mm256_loadu_ps(&m_binormals.z[k + 1]), _mm256_loadu_ps(&m_binormals.z[k - 1]));
+		const __m256 dB = DotAVX(dbx, dby, dbz,
+			_mm256_loadu_ps(&m_normals.x[k]), _mm256_loadu_ps(&m_normals.y[k]), _mm256_loadu_ps(&m_normals.z[k]));
+		_mm256_storeu_ps(&m_torsions[k], _mm256_mul_ps(_mm256_mul_ps(minusOne, dB), SafeInverseAVX(ds)));
+	}
+	return i;
+}
+#endif
+
+void PolylineGeometry::FramesRange(size_t first, size_t count) {
+	// widest lanes first, the remainder is handled by the narrower kernels
+	size_t done = 0;
+#ifdef SIMD_AVX
+	done += FramesAVX(first + done, count - done);
+#endif
+#ifdef SIMD_SSE
+	done += FramesSSE(first + done, count - done);
+#endif
+	FramesScalar(first + done, count - done);
+}
+
+void PolylineGeometry::TorsionRange(size_t first, size_t count) {
+	size_t done = 0;
+#ifdef SIMD_AVX
+	done += TorsionAVX(first + done, count - done);
+#endif
+#ifdef SIMD_SSE
+	done += TorsionSSE(first + done, count - done);
+#endif
+	TorsionScalar(first + done, count - done);
+}
+
+void PolylineGeometry::FillDegenerateFrames() {
+	const size_t n = GetPointCount();
+
+	// tangents: the end edges, then the neighbour where the edges cancel out or the points coincide
+	m_tangents.Set(0, SafeNormalize(m_points[1] - m_points[0]));
+	m_tangents.Set(n - 1, SafeNormalize(m_points[n - 1] - m_points[n - 2]));
+	size_t firstTangent = 0;
+	while (firstTangent < n && glm::dot(m_tangents[firstTangent], m_tangents[firstTangent]) < 0.5f) {
+		++firstTangent;
+	}
+	if (firstTangent == n) {
+		// every point is the same
+		return;
+	}
+	for (size_t i = 0; i < n; ++i) {
+		if (glm::dot(m_tangents[i], m_tangents[i]) < 0.5f) {
+			m_tangents.Set(i, m_tangents[i < firstTangent ? firstTangent : i - 1]);
+		}
+	}
+
+	// frames: the binormal of the neighbour projected onto the normal plane
+	auto transport = [this](size_t from, size_t to) {
+		glm::vec3 tangent = m_tangents[to];
+		glm::vec3 binormal = m_binormals[from];
+		binormal = SafeNormalize(binormal - glm::dot(binormal, tangent) * tangent);
+		if (glm::dot(binormal, binormal) < 0.5f) {
+			// the tangent turned onto the binormal, the old normal is perpendicular to both
+			binormal = SafeNormalize(glm::cross(tangent, m_normals[from]));
+		}
+		m_binormals.Set(to, binormal);
+		m_normals.Set(to, glm::cross(binormal, tangent));
+	};
+	size_t firstFrame = 0;
+	while (firstFrame < n && glm::dot(m_binormals[firstFrame], m_binormals[firstFrame]) < 0.5f) {
+		++firstFrame;
+	}
+	if (firstFrame == n) {
+		// straight line, any normal plane direction will do
+		firstFrame = 0;
+		glm::vec3 tangent = m_tangents[0];
+		glm::vec3 binormal = glm::normalize(glm::cross(tangent, std::abs(tangent.x) < 0.9f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0)));
+		m_binormals.Set(0, binormal);
+		m_normals.Set(0, glm::cross(binormal, tangent));
+	}
+	for (size_t i = firstFrame; i-- > 0; ) {
+		transport(i + 1, i);
+	}
+	for (size_t i = firstFrame + 1; i < n; ++i) {
+		if (glm::dot(m_binormals[i], m_binormals[i]) < 0.5f) {
+			transport(i - 1, i);
+		}
+	}
+}
+
+void PolylineGeometry::Compute(const std::vector<glm::vec4>& points, int threadCount) {
+	const size_t n = points.size();
+	m_points.Resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		m_points.Set(i, glm::vec3(points[i]));
+	}
+	m_tangents.Resize(n);
+	m_normals.Resize(n);
+	m_binormals.Resize(n);
+	m_curvatures.assign(n, 0.f);
+	m_torsions.assign(n, 0.f);
+	if (n < 2) {
+		return;
+	}
+
+	// the inner vertices in parallel, the torsion needs the frames of the neighbours
+	const size_t inner = n - 2;
+	ParallelFor(inner, threadCount, MIN_POINTS_PER_THREAD, [this](size_t first, size_t count) {
+		FramesRange(1 + first, count);
+	});
+	FillDegenerateFrames();
+	ParallelFor(inner, threadCount, MIN_POINTS_PER_THREAD, [this](size_t first, size_t count) {
+		TorsionRange(1 + first, count);
+	});
+
+	if (n > 2) {
+		m_curvatures[0] = m_curvatures[1];
+		m_curvatures[n - 1] = m_curvatures[n - 2];
+		m_torsions[0] = m_torsions[1];
+		m_torsions[n - 1] = m_torsions[n - 2];
+	}
+}
+
+void PolylineGeometry::Clear() {
+	m_points.Resize(0);
+	m_tangents.Resize(0);
+	m_normals.Resize(0);
+	m_binormals.Resize(0);
+	m_curvatures.clear();
+	m_torsions.clear();
+}
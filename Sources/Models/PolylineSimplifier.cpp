@@ -0,0 +1,177 @@
+#include "../../Headers/include_all.h"
+
+static float SegmentDistance(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b) {
+	glm::vec3 d = b - a;
+	float len2 = glm::dot(d, d);
+	float s = len2 > 0.f ? glm::clamp(glm::dot(p - a, d) / len2, 0.f, 1.f) : 0.f;
+	return glm::length(p - (a + s * d));
+}
+
+// binary min-heap of (cost, point), the position of every point is kept,
+// so a changed cost is restored in place instead of pushing a new entry
+class CostHeap {
+protected:
+	struct Entry {
+		float cost;
+		int point;
+	};
+	std::vector<Entry> m_heap{};
+	std::vector<int> m_position{};
+
+	inline bool Less(int a, int b) const {
+		return m_heap[a].cost < m_heap[b].cost;
+	}
+	inline void Swap(int a, int b) {
+		std::swap(m_heap[a], m_heap[b]);
+		m_position[m_heap[a].point] = a;
+		m_position[m_heap[b].point] = b;
+	}
+	void Up(int k) {
+		while (k > 0 && Less(k, (k - 1) / 2)) {
+			Swap(k, (k - 1) / 2);
+			k = (k - 1) / 2;
+		}
+	}
+	void Down(int k) {
+		int size = m_heap.size();
+		while (true) {
+			int smallest = k;
+			for (int child : { 2 * k + 1, 2 * k + 2 }) {
+				if (child < size && Less(child, smallest)) {
+					smallest = child;
+				}
+			}
+			if (smallest == k) {
+				return;
+			}
+			Swap(k, smallest);
+			k = smallest;
+		}
+	}
+
+public:
+	CostHeap(const std::vector<float>& cost, int first, int last) : m_position(cost.size(), -1) {
+		for (int i = first; i < last; ++i) {
+			m_position[i] = m_heap.size();
+			m_heap.push_back({ cost[i], i });
+		}
+		for (int k = m_heap.size() / 2 - 1; k >= 0; --k) {
+			Down(k);
+		}
+	}
+	inline bool IsEmpty() const {
+		return m_heap.empty();
+	}
+	int Pop() {
+		int top = m_heap[0].point;
+		Swap(0, m_heap.size() - 1);
+		m_heap.pop_back();
+		m_position[top] = -1;
+		if (!m_heap.empty()) {
+			Down(0);
+		}
+		return top;
+	}
+	void Update(int i, float cost) {
+		int k = m_position[i];
+		if (k < 0) {
+			return;
+		}
+		m_heap[k].cost = cost;
+		Up(k);
+		Down(m_position[i]);
+	}
+};
+
+void PolylineSimplifier::Build(const std::vector<glm::vec4>& points) {
+	int n = points.size();
+	m_importance.assign(n, std::numeric_limits<float>::max());
+	m_indices.clear();
+	m_levels.clear();
+	if (n == 0) {
+		return;
+	}
+	m_min = glm::vec3(points[0]);
+	m_max = glm::vec3(points[0]);
+	for (const auto& point : points) {
+		m_min = glm::min(m_min, glm::vec3(point));
+		m_max = glm::max(m_max, glm::vec3(point));
+	}
+
+	// neighbours in the remaining polyline
+	std::vector<int> prev(n), next(n);
+	for (int i = 0; i < n; ++i) {
+		prev[i] = i - 1;
+		next[i] = i + 1;
+	}
+	// deviation bound of the removed points from the segment i -> next[i]. Removing i moves the points of both
+	// segments at most by the distance of i from the new segment, so this bound grows by that distance.
+	std::vector<float> segmentError(n, 0.f);
+	auto cost = [&](int i) {
+		float d = SegmentDistance(glm::vec3(points[i]), glm::vec3(points[prev[i]]), glm::vec3(points[next[i]]));
+		return d + glm::max(segmentError[prev[i]], segmentError[i]);
+	};
+
+	std::vector<float> current(n, 0.f);
+	for (int i = 1; i + 1 < n; ++i) {
+		current[i] = cost(i);
+	}
+	CostHeap heap(current, 1, glm::max(n - 1, 1));
+	float last = 0.f;
+	while (!heap.IsEmpty()) {
+		int i = heap.Pop();
+		// a point removed later never counts as less important than the ones before it
+		last = glm::max(last, current[i]);
+		m_importance[i] = last;
+		segmentError[prev[i]] = current[i];
+		next[prev[i]] = next[i];
+		prev[next[i]] = prev[i];
+		for (int j : { prev[i], next[i] }) {
+			if (j > 0 && j + 1 < n) {
+				current[j] = cost(j);
+				heap.Update(j, current[j]);
+			}
+		}
+	}
+
+	// level 0 draws the points directly
+	m_levels.push_back({ -1, n, 0.f });
+	std::vector<float> sorted(m_importance);
+	std::sort(sorted.begin(), sorted.end(), std::greater<float>());
+	for (int target = n / 2; target >= MIN_LEVEL_POINTS; target /= 2) {
+		// the points ranked above the target, ties are kept together
+		float threshold = sorted[target - 1];
+		int count = std::upper_bound(sorted.begin(), sorted.end(), threshold, std::greater<float>()) - sorted.begin();
+		if (count >= m_levels.back().count) {
+			continue;
+		}
+		Level level;
+		level.first = m_indices.size();
+		level.count = count;
+		level.error = count < n ? sorted[count] : 0.f;
+		for (int i = 0; i < n; ++i) {
+			if (m_importance[i] >= threshold) {
+				m_indices.push_back(i);
+			}
+		}
+		m_levels.push_back(level);
+	}
+}
+
+int PolylineSimplifier::SelectLevel(float tolerance) const {
+	for (int level = m_levels.size() - 1; level > 0; --level) {
+		if (m_levels[level].error <= tolerance) {
+			return level;
+		}
+	}
+	return 0;
+}
+
+void PolylineSimplifier::Extract(float tolerance, std::vector<GLuint>& out) const {
+	out.clear();
+	for (int i = 0; i < m_importance.size(); ++i) {
+		if (m_importance[i] > tolerance) {
+			out.push_back(i);
+		}
+	}
+}
@@ -87,6 +87,11 @@ void CMyApp::InitShaders()
 		.ShaderStage(GL_FRAGMENT_SHADER, "Shaders/BezierSurface/Frag_BezierSurfaceSelected.frag")
 		.Link();
 
+	m_programBezierSurfaceGridID = glCreateProgram();
+	ProgramBuilder{ m_programBezierSurfaceGridID }
+		.ShaderStage(GL_COMPUTE_SHADER, "Shaders/BezierSurface/Comp_BezierSurfaceGrid.comp")
+		.Link();
+
 	// Light selection
 	m_programDirectionLightID = glCreateProgram();
 	ProgramBuilder{ m_programDirectionLightID }
@@ -143,6 +148,8 @@ void CMyApp::CleanShaders()
 	m_programBezierSurfaceID = 0;
 	glDeleteProgram(m_programBezierSurfaceSelectedID);
 	m_programBezierSurfaceSelectedID = 0;
+	glDeleteProgram(m_programBezierSurfaceGridID);
+	m_programBezierSurfaceGridID = 0;
 
 	glDeleteProgram(m_programDirectionLightID);
 	m_programDirectionLightID = 0;
@@ -249,7 +256,8 @@ void CMyApp::InitModels() {
 				m_programBezierSurfaceSelectedID,
 				glm::vec2{10, 10},
 				"Bezier-surface",
-				true, false
+				true, false,
+				m_programBezierSurfaceGridID
 			}
 		));
 		((BezierSurface*)m_models[m_models.size() - 1])->SetCtrlPoints(glm::vec2{ 6, 5 }, std::vector<glm::vec4>{
@@ -276,7 +284,8 @@ void CMyApp::InitModels() {
 				m_programBezierSurfaceSelectedID,
 				glm::vec2{10, 10},
 				"Bezier-surface-2",
-				true, false
+				true, false,
+				m_programBezierSurfaceGridID
 			}
 		));
 		((BezierSurface*)m_models[m_models.size() - 1])->SetCtrlPoints(glm::vec2{ 3, 3 }, std::vector<glm::vec4>{
@@ -465,7 +474,8 @@ void CMyApp::InitModels() {
 							m_programBezierSurfaceSelectedID,
 							glm::vec2{10, 10},
 							name.c_str(),
-							true, false
+							true, false,
+							m_programBezierSurfaceGridID
 						}
 					));
 					std::vector<std::vector<glm::vec3>> p = BezierSurfaceInterpolation::getOvershootTestGrid();
@@ -503,7 +513,8 @@ void CMyApp::InitModels() {
 							m_programBezierSurfaceSelectedID,
 							glm::vec2{10, 10},
 							name.c_str(),
-							true, false
+							true, false,
+							m_programBezierSurfaceGridID
 						}
 					));
 					std::vector<std::vector<glm::vec3>> p = BezierSurfaceInterpolation::getLShapedDensityGrid();
@@ -542,7 +553,8 @@ void CMyApp::InitModels() {
 							m_programBezierSurfaceSelectedID,
 							glm::vec2{10, 10},
 							name.c_str(),
-							true, false
+							true, false,
+							m_programBezierSurfaceGridID
 						}
 					));
 					std::vector<std::vector<glm::vec3>> p = BezierSurfaceInterpolation::getStretchingTestGrid();
@@ -667,6 +679,11 @@ void CMyApp::CleanBuffers() {
 	glDeleteBuffers(1, &m_LightsBufferID);
 	m_LightsBufferID = 0;
 
+	// shared Bernstein tables of curves and surfaces
+	BernsteinTableCache::Clean();
+	// shared index buffers of surface grids
+	GridIndexCache::Clean();
+
 	// glDeleteFramebuffers(1, &m_FBOShadowID);
 	// m_FBOShadowID = 0;
 }
@@ -947,6 +964,19 @@ void CMyApp::RenderGUI()
 			));
 		}
 		ImGui::SameLine();
+		if (ImGui::Button("Add NURBS circle")) {
+			BSpline* circle = BSpline::CreateArc(glm::vec3(0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), 10.f, 0.f, 2.f * glm::pi<float>(),
+				BSplineParams{
+					m_programBSplineID,
+					m_programBSplineSelectedID,
+					40
+				}
+			);
+			if (circle != nullptr) {
+				m_models.push_back(circle);
+			}
+		}
+		ImGui::SameLine();
 		if (ImGui::Button("Add Discrete-curve")) {
 			m_models.push_back(new DiscreteCurve(
 				DiscreteCurveParams{
@@ -960,7 +990,11 @@ void CMyApp::RenderGUI()
 			m_models.push_back(new BezierSurface(
 				BezierSurfaceParams{
 					m_programBezierSurfaceID,
-					m_programBezierSurfaceSelectedID
+					m_programBezierSurfaceSelectedID,
+					glm::vec2{ 10, 10 },
+					"",
+					true, false,
+					m_programBezierSurfaceGridID
 				}
 			));
 		}